@@ -0,0 +1,43 @@
+#pragma once
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCHMARK_MIN_SECONDS 0.2   // each benchmark repeats until this time is reached
+
+typedef void (*BenchmarkFunction)(void *context);
+
+static volatile uint64_t benchmarkSink;   // results are written here, so compiler can't drop measured code
+
+static double benchmarkSeconds(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec + (double) time.tv_nsec / 1e9;
+}
+
+// Runs function repeatedly and prints average time per run and throughput for 'items' processed per run
+static double runBenchmark(const char *name, BenchmarkFunction function, void *context, uint64_t items) {
+    function(context);  // warm up caches
+    uint64_t runs = 0;
+    double start = benchmarkSeconds();
+    double elapsed;
+    do {
+        function(context);
+        runs++;
+        elapsed = benchmarkSeconds() - start;
+    } while (elapsed < BENCHMARK_MIN_SECONDS);
+
+    double perRun = elapsed / (double) runs;
+    printf("%-56s %12.3f us %10.1f M items/s\n", name, perRun * 1e6, (double) items / perRun / 1e6);
+    return perRun;
+}
+
+static void printBenchmarkHeader(const char *title) {
+    printf("\n%s\n", title);
+    printf("--------------------------------------------------------------------------------------------\n");
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "BaseBenchmarkTemplate.h"
+#include "include/BufferVector.h"
+
+CREATE_VECTOR_TYPE(int32_t, bench32);
+
+#define BULK_BENCHMARK_SIZE 65536
+#define BULK_BENCHMARK_SHIFTS 256
+
+typedef struct BulkBenchmarkContext {
+    bench32Vector *source;
+    bench32Vector *dest;
+    int32_t *array;
+} BulkBenchmarkContext;
+
+// Element by element versions, as buffer vector methods were implemented before bulk copies
+static void legacyAddAll(bench32Vector *vecDest, bench32Vector *vecSource) {
+    for (uint32_t i = 0; i < vecSource->size; i++) {
+        if (vecDest->size + 1 > vecDest->capacity) return;
+        vecDest->items[vecDest->size++] = vecSource->items[i];
+    }
+}
+
+static void legacyAddAt(bench32Vector *vector, uint32_t index, int32_t item) {
+    for (uint32_t i = vector->size; i > index; i--) {
+        vector->items[i] = vector->items[i - 1];
+    }
+    vector->items[index] = item;
+    vector->size++;
+}
+
+static int32_t legacyRemoveAt(bench32Vector *vector, uint32_t index) {
+    int32_t item = vector->items[index];
+    for (uint32_t i = index; i < vector->size - 1; i++) {
+        vector->items[i] = vector->items[i + 1];
+    }
+    vector->size--;
+    return item;
+}
+
+static void legacyClear(bench32Vector *vector) {
+    for (uint32_t i = 0; i < vector->size; i++) {
+        vector->items[i] = 0;
+    }
+    vector->size = 0;
+}
+
+static void benchLegacyAddAll(void *context) {
+    BulkBenchmarkContext *ctx = context;
+    ctx->dest->size = 0;
+    legacyAddAll(ctx->dest, ctx->source);
+    benchmarkSink += ctx->dest->items[ctx->dest->size - 1];
+}
+
+static void benchBulkAddAll(void *context) {
+    BulkBenchmarkContext *ctx = context;
+    bench32VecReset(ctx->dest);
+    bench32VecAddAll(ctx->dest, ctx->source);
+    benchmarkSink += ctx->dest->items[ctx->dest->size - 1];
+}
+
+static void benchLegacyFromArray(void *context) {
+    BulkBenchmarkContext *ctx = context;
+    ctx->dest->size = 0;
+    for (uint32_t i = 0; i < BULK_BENCHMARK_SIZE; i++) {
+        ctx->dest->items[ctx->dest->size++] = ctx->array[i];
+    }
+    benchmarkSink += ctx->dest->items[ctx->dest->size - 1];
+}
+
+static void benchBulkFromArray(void *context) {
+    BulkBenchmarkContext *ctx = context;
+    bench32VecReset(ctx->dest);
+    bench32VecFromArray(ctx->dest, ctx->array, BULK_BENCHMARK_SIZE);
+    benchmarkSink += ctx->dest->items[ctx->dest->size - 1];
+}
+
+static void benchLegacyInsertRemove(void *context) {
+    BulkBenchmarkContext *ctx = context;
+    for (uint32_t i = 0; i < BULK_BENCHMARK_SHIFTS; i++) {
+        legacyAddAt(ctx->dest, 0, (int32_t) i);
+        benchmarkSink += legacyRemoveAt(ctx->dest, 0);
+    }
+}
+
+static void benchBulkInsertRemove(void *context) {
+    BulkBenchmarkContext *ctx = context;
+    for (uint32_t i = 0; i < BULK_BENCHMARK_SHIFTS; i++) {
+        bench32VecAddAt(ctx->dest, 0, (int32_t) i);
+        benchmarkSink += bench32VecRemoveAt(ctx->dest, 0);
+    }
+}
+
+static void benchLegacyClear(void *context) {
+    BulkBenchmarkContext *ctx = context;
+    ctx->dest->size = BULK_BENCHMARK_SIZE;
+    legacyClear(ctx->dest);
+    benchmarkSink += ctx->dest->items[BULK_BENCHMARK_SIZE / 2];
+}
+
+static void benchBulkClear(void *context) {
+    BulkBenchmarkContext *ctx = context;
+    ctx->dest->size = BULK_BENCHMARK_SIZE;
+    bench32VecClear(ctx->dest);
+    benchmarkSink += ctx->dest->items[BULK_BENCHMARK_SIZE / 2];
+}
+
+static void runBulkCopyBenchmarks() {
+    bench32Vector sourceVector, destVector;
+    bench32Vector *source = newbench32BuffVector(&sourceVector, malloc(sizeof(int32_t) * BULK_BENCHMARK_SIZE), BULK_BENCHMARK_SIZE);
+    bench32Vector *dest = newbench32BuffVector(&destVector, malloc(sizeof(int32_t) * (BULK_BENCHMARK_SIZE + 1)), BULK_BENCHMARK_SIZE + 1);
+    int32_t *array = malloc(sizeof(int32_t) * BULK_BENCHMARK_SIZE);
+    for (uint32_t i = 0; i < BULK_BENCHMARK_SIZE; i++) {
+        array[i] = (int32_t) (i * 7);
+        bench32VecAdd(source, (int32_t) i);
+    }
+    BulkBenchmarkContext context = {.source = source, .dest = dest, .array = array};
+
+    printBenchmarkHeader("Buffer vector bulk copy (int32_t, 65536 elements)");
+    runBenchmark("AddAll: element loop", benchLegacyAddAll, &context, BULK_BENCHMARK_SIZE);
+    runBenchmark("AddAll: memcpy", benchBulkAddAll, &context, BULK_BENCHMARK_SIZE);
+    runBenchmark("FromArray: element loop", benchLegacyFromArray, &context, BULK_BENCHMARK_SIZE);
+    runBenchmark("FromArray: memcpy", benchBulkFromArray, &context, BULK_BENCHMARK_SIZE);
+    runBenchmark("Clear: element loop", benchLegacyClear, &context, BULK_BENCHMARK_SIZE);
+    runBenchmark("Clear: memset", benchBulkClear, &context, BULK_BENCHMARK_SIZE);
+
+    bench32VecReset(dest);
+    bench32VecAddAll(dest, source);
+    dest->size--;
+    runBenchmark("AddAt + RemoveAt at front: element loop", benchLegacyInsertRemove, &context, BULK_BENCHMARK_SHIFTS);
+    runBenchmark("AddAt + RemoveAt at front: memmove", benchBulkInsertRemove, &context, BULK_BENCHMARK_SHIFTS);
+
+    free(array);
+    free(source->items);
+    free(dest->items);
+}
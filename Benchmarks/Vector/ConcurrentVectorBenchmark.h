@@ -0,0 +1,105 @@
+#pragma once
+
+#include "BaseBenchmarkTemplate.h"
+#include "include/ConcurrentVector.h"
+#include "include/ShardedVector.h"
+#ifdef VECTOR_ENABLE_THREADS
+#include <pthread.h>
+#endif
+
+#define CONCURRENT_APPEND_COUNT 1000000
+
+typedef struct AppendContext {
+    ThreadPool pool;
+    uint32_t threadCount;
+    Vector vector;
+    ConcurrentVector concurrentVector;
+    ShardedVector shardedVector;
+#ifdef VECTOR_ENABLE_THREADS
+    pthread_mutex_t lock;
+#endif
+} AppendContext;
+
+static void appendLocked(void *context) {   // baseline: every vectorAdd() is wrapped in mutex
+    AppendContext *ctx = context;
+    for (uint32_t i = 0; i < CONCURRENT_APPEND_COUNT / ctx->threadCount; i++) {
+#ifdef VECTOR_ENABLE_THREADS
+        pthread_mutex_lock(&ctx->lock);
+#endif
+        vectorAdd(ctx->vector, (VectorValueType) (uintptr_t) i);
+#ifdef VECTOR_ENABLE_THREADS
+        pthread_mutex_unlock(&ctx->lock);
+#endif
+    }
+}
+
+static void appendConcurrent(void *context) {
+    AppendContext *ctx = context;
+    for (uint32_t i = 0; i < CONCURRENT_APPEND_COUNT / ctx->threadCount; i++) {
+        concurrentVectorAdd(ctx->concurrentVector, (VectorValueType) (uintptr_t) i);
+    }
+}
+
+static void appendSharded(void *context) {
+    AppendContext *ctx = context;
+    uint32_t shard = getThreadPoolWorkerIndex(ctx->pool);
+    for (uint32_t i = 0; i < CONCURRENT_APPEND_COUNT / ctx->threadCount; i++) {
+        shardedVectorAdd(ctx->shardedVector, shard, (VectorValueType) (uintptr_t) i);
+    }
+}
+
+static void runAppenders(AppendContext *ctx, ThreadPoolTask task) {
+    for (uint32_t i = 0; i < ctx->threadCount; i++) {
+        if (!threadPoolSubmit(ctx->pool, task, ctx)) task(ctx);
+    }
+    threadPoolWait(ctx->pool);
+}
+
+static void benchLockedAppend(void *context) {
+    AppendContext *ctx = context;
+    ctx->vector = getVectorInstance(1024);
+    runAppenders(ctx, appendLocked);
+    benchmarkSink += getVectorSize(ctx->vector);
+    vectorDelete(ctx->vector);
+}
+
+static void benchConcurrentAppend(void *context) {
+    AppendContext *ctx = context;
+    ctx->concurrentVector = getConcurrentVectorInstance(1024);
+    runAppenders(ctx, appendConcurrent);
+    benchmarkSink += getConcurrentVectorSize(ctx->concurrentVector);
+    concurrentVectorDelete(ctx->concurrentVector);
+}
+
+static void benchShardedAppend(void *context) {    // collect into one Vector is part of measured time
+    AppendContext *ctx = context;
+    ctx->shardedVector = getShardedVectorInstance(getThreadPoolSize(ctx->pool), 1024);
+    ctx->vector = getVectorInstance(1024);
+    runAppenders(ctx, appendSharded);
+    shardedVectorCollect(ctx->shardedVector, ctx->vector, ctx->pool);
+    benchmarkSink += getVectorSize(ctx->vector);
+    vectorDelete(ctx->vector);
+    shardedVectorDelete(ctx->shardedVector);
+}
+
+static void runConcurrentVectorBenchmarks() {
+    AppendContext context = {0};
+#ifdef VECTOR_ENABLE_THREADS
+    pthread_mutex_init(&context.lock, NULL);
+#endif
+    printBenchmarkHeader("Concurrent append contention (1000000 items split between threads)");
+    char name[64];
+    for (context.threadCount = 1; context.threadCount <= 16; context.threadCount *= 2) {
+        context.pool = getThreadPoolInstance(context.threadCount);
+        snprintf(name, sizeof(name), "%2u threads: mutex and vectorAdd()", context.threadCount);
+        runBenchmark(name, benchLockedAppend, &context, CONCURRENT_APPEND_COUNT);
+        snprintf(name, sizeof(name), "%2u threads: concurrentVectorAdd()", context.threadCount);
+        runBenchmark(name, benchConcurrentAppend, &context, CONCURRENT_APPEND_COUNT);
+        snprintf(name, sizeof(name), "%2u threads: shardedVectorAdd() and collect", context.threadCount);
+        runBenchmark(name, benchShardedAppend, &context, CONCURRENT_APPEND_COUNT);
+        threadPoolDelete(context.pool);
+    }
+#ifdef VECTOR_ENABLE_THREADS
+    pthread_mutex_destroy(&context.lock);
+#endif
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "BaseBenchmarkTemplate.h"
+#include "include/BufferVector.h"
+
+#define PARALLEL_SEARCH_SIZE 8000000
+
+typedef struct ParallelSearchContext {
+    bench32Vector *vector;
+    int32_t value;
+    ThreadPool pool;
+} ParallelSearchContext;
+
+static void benchIndexOf(void *context) {
+    ParallelSearchContext *ctx = context;
+    benchmarkSink += (uint32_t) bench32VecIndexOf(ctx->vector, ctx->value);
+}
+
+static void benchParallelIndexOf(void *context) {
+    ParallelSearchContext *ctx = context;
+    benchmarkSink += (uint32_t) bench32VecParallelIndexOf(ctx->vector, ctx->value, ctx->pool);
+}
+
+static void runParallelSearchBenchmarks() {
+    bench32Vector vector;
+    ParallelSearchContext context = {
+            .vector = newbench32BuffVector(&vector, malloc(sizeof(int32_t) * PARALLEL_SEARCH_SIZE), PARALLEL_SEARCH_SIZE)
+    };
+    for (uint32_t i = 0; i < PARALLEL_SEARCH_SIZE; i++) {
+        bench32VecAdd(context.vector, (int32_t) i);
+    }
+
+    printBenchmarkHeader("Parallel search (int32_t, 8000000 elements, items are scanned elements)");
+    int32_t positions[] = {PARALLEL_SEARCH_SIZE / 100, PARALLEL_SEARCH_SIZE * 3 / 4, -1};
+    char name[64];
+    for (uint32_t i = 0; i < sizeof(positions) / sizeof(positions[0]); i++) {
+        context.value = positions[i];
+        uint32_t scanned = (positions[i] >= 0) ? (uint32_t) positions[i] + 1 : PARALLEL_SEARCH_SIZE;
+        snprintf(name, sizeof(name), "<type>VecIndexOf() match at %d", positions[i]);
+        runBenchmark(name, benchIndexOf, &context, scanned);
+        for (uint32_t threads = 2; threads <= 8; threads *= 2) {
+            context.pool = getThreadPoolInstance(threads);
+            snprintf(name, sizeof(name), "%2u threads: <type>VecParallelIndexOf()", threads);
+            runBenchmark(name, benchParallelIndexOf, &context, scanned);
+            threadPoolDelete(context.pool);
+        }
+    }
+    free(context.vector->items);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "BaseBenchmarkTemplate.h"
+#include "include/BufferVector.h"
+
+#define PARALLEL_SET_SIZE 2000000
+
+typedef struct ParallelSetContext {
+    int32_t *firstItems;
+    int32_t *secondItems;
+    bench32Vector *first;
+    bench32Vector *second;
+    ThreadPool pool;
+} ParallelSetContext;
+
+static void resetSetInputs(ParallelSetContext *ctx) {
+    bench32VecClear(ctx->first);
+    bench32VecFromArray(ctx->first, ctx->firstItems, PARALLEL_SET_SIZE);
+    bench32VecClear(ctx->second);
+    bench32VecFromArray(ctx->second, ctx->secondItems, PARALLEL_SET_SIZE);
+}
+
+#define SET_OPERATION_BENCHMARK(OPERATION)                                      \
+static void bench ##OPERATION(void *context) {                                  \
+    ParallelSetContext *ctx = context;                                          \
+    resetSetInputs(ctx);                                                        \
+    benchmarkSink += bench32Vec ##OPERATION(ctx->first, ctx->second)->size;     \
+}                                                                               \
+                                                                                \
+static void benchParallel ##OPERATION(void *context) {                          \
+    ParallelSetContext *ctx = context;                                          \
+    resetSetInputs(ctx);                                                        \
+    benchmarkSink += bench32VecParallel ##OPERATION(ctx->first, ctx->second, ctx->pool)->size;  \
+}
+
+SET_OPERATION_BENCHMARK(Union)
+SET_OPERATION_BENCHMARK(Intersect)
+SET_OPERATION_BENCHMARK(Subtract)
+
+static void runParallelSetBenchmarks() {
+    bench32Vector first, second;
+    ParallelSetContext context = {
+            .firstItems = malloc(sizeof(int32_t) * PARALLEL_SET_SIZE),
+            .secondItems = malloc(sizeof(int32_t) * PARALLEL_SET_SIZE),
+            .first = newbench32BuffVector(&first, malloc(sizeof(int32_t) * PARALLEL_SET_SIZE * 2), PARALLEL_SET_SIZE * 2),
+            .second = newbench32BuffVector(&second, malloc(sizeof(int32_t) * PARALLEL_SET_SIZE), PARALLEL_SET_SIZE)
+    };
+    for (uint32_t i = 0; i < PARALLEL_SET_SIZE; i++) {  // sorted inputs with half of values in common
+        context.firstItems[i] = (int32_t) (i * 2);
+        context.secondItems[i] = (int32_t) (i * 2 + (i % 2) * 3);
+    }
+
+    printBenchmarkHeader("Parallel set operations (sorted int32_t, 2 x 2000000 elements)");
+    char name[64];
+    runBenchmark("<type>VecUnion()", benchUnion, &context, PARALLEL_SET_SIZE * 2);
+    runBenchmark("<type>VecIntersect()", benchIntersect, &context, PARALLEL_SET_SIZE * 2);
+    runBenchmark("<type>VecSubtract()", benchSubtract, &context, PARALLEL_SET_SIZE * 2);
+    for (uint32_t threads = 2; threads <= 8; threads *= 2) {
+        context.pool = getThreadPoolInstance(threads);
+        snprintf(name, sizeof(name), "%2u threads: <type>VecParallelUnion()", threads);
+        runBenchmark(name, benchParallelUnion, &context, PARALLEL_SET_SIZE * 2);
+        snprintf(name, sizeof(name), "%2u threads: <type>VecParallelIntersect()", threads);
+        runBenchmark(name, benchParallelIntersect, &context, PARALLEL_SET_SIZE * 2);
+        snprintf(name, sizeof(name), "%2u threads: <type>VecParallelSubtract()", threads);
+        runBenchmark(name, benchParallelSubtract, &context, PARALLEL_SET_SIZE * 2);
+        threadPoolDelete(context.pool);
+    }
+    free(context.firstItems);
+    free(context.secondItems);
+    free(context.first->items);
+    free(context.second->items);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "BaseBenchmarkTemplate.h"
+#include "include/BufferVector.h"
+#include "include/Vector.h"
+
+#define PARALLEL_SORT_SIZE 2000000
+
+typedef struct ParallelSortContext {
+    int32_t *source;
+    bench32Vector *vector;
+    Vector pointerVector;
+    ThreadPool pool;
+} ParallelSortContext;
+
+static int comparePointerInt32(const void *one, const void *two) {
+    intptr_t first = (intptr_t) *(VectorValueType const *) one;
+    intptr_t second = (intptr_t) *(VectorValueType const *) two;
+    return (first > second) - (first < second);
+}
+
+static void benchParallelSort(void *context) {
+    ParallelSortContext *ctx = context;
+    memcpy(ctx->vector->items, ctx->source, sizeof(int32_t) * PARALLEL_SORT_SIZE);
+    bench32VecParallelSort(ctx->vector, ctx->pool);
+    benchmarkSink += (uint32_t) ctx->vector->items[0];
+}
+
+static void benchSampleSort(void *context) {
+    ParallelSortContext *ctx = context;
+    memcpy(ctx->vector->items, ctx->source, sizeof(int32_t) * PARALLEL_SORT_SIZE);
+    parallelSort(ctx->vector->items, PARALLEL_SORT_SIZE, sizeof(int32_t), compareInt32Values, ctx->pool);
+    benchmarkSink += (uint32_t) ctx->vector->items[0];
+}
+
+static void benchVectorParallelSort(void *context) {
+    ParallelSortContext *ctx = context;
+    for (uint32_t i = 0; i < PARALLEL_SORT_SIZE; i++) {
+        vectorPut(ctx->pointerVector, i, (VectorValueType) (intptr_t) ctx->source[i]);
+    }
+    vectorParallelSort(ctx->pointerVector, comparePointerInt32, ctx->pool);
+    benchmarkSink += (uintptr_t) vectorGet(ctx->pointerVector, 0);
+}
+
+static void runParallelSortBenchmarks() {
+    bench32Vector vector;
+    ParallelSortContext context = {
+            .source = malloc(sizeof(int32_t) * PARALLEL_SORT_SIZE),
+            .vector = newbench32BuffVectorOf(&vector, malloc(sizeof(int32_t) * PARALLEL_SORT_SIZE), PARALLEL_SORT_SIZE, PARALLEL_SORT_SIZE),
+            .pointerVector = getVectorInstance(PARALLEL_SORT_SIZE)
+    };
+    srand(17);
+    for (uint32_t i = 0; i < PARALLEL_SORT_SIZE; i++) {
+        context.source[i] = rand();
+        vectorAdd(context.pointerVector, NULL);
+    }
+
+    printf("\nOnline CPUs: %u\n", getOnlineCpuCount());
+    printBenchmarkHeader("Parallel sort scaling (int32_t, 2000000 elements)");
+    char name[64];
+    for (uint32_t threads = 1; threads <= 16; threads *= 2) {
+        context.pool = getThreadPoolInstance(threads);
+        snprintf(name, sizeof(name), "%2u threads: <type>VecParallelSort() radix", threads);
+        runBenchmark(name, benchParallelSort, &context, PARALLEL_SORT_SIZE);
+        snprintf(name, sizeof(name), "%2u threads: parallelSort() sample sort", threads);
+        runBenchmark(name, benchSampleSort, &context, PARALLEL_SORT_SIZE);
+        snprintf(name, sizeof(name), "%2u threads: vectorParallelSort()", threads);
+        runBenchmark(name, benchVectorParallelSort, &context, PARALLEL_SORT_SIZE);
+        threadPoolDelete(context.pool);
+    }
+    free(context.source);
+    free(context.vector->items);
+    vectorDelete(context.pointerVector);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "BaseBenchmarkTemplate.h"
+#include "include/NumberBufferVector.h"
+
+CREATE_VECTOR_TYPE(double, benchF64);
+CREATE_NUMBER_VECTOR_METHODS(int32_t, bench32);
+CREATE_NUMBER_VECTOR_METHODS(double, benchF64);
+
+#define REDUCTION_BENCHMARK_SIZE 65536
+
+typedef struct ReductionBenchmarkContext {
+    bench32Vector *intVector;
+    benchF64Vector *doubleVector;
+} ReductionBenchmarkContext;
+
+static void benchScalarMinMax(void *context) {
+    bench32Vector *vector = ((ReductionBenchmarkContext *) context)->intVector;
+    int32_t min = vector->items[0];
+    int32_t max = vector->items[0];
+    for (uint32_t i = 1; i < vector->size; i++) {
+        if (vector->items[i] < min) min = vector->items[i];
+        if (vector->items[i] > max) max = vector->items[i];
+    }
+    benchmarkSink += (uint64_t) (min + max);
+}
+
+static void benchVectorMinMax(void *context) {
+    int32_t min, max;
+    bench32VecMinMax(((ReductionBenchmarkContext *) context)->intVector, &min, &max);
+    benchmarkSink += (uint64_t) (min + max);
+}
+
+static void benchScalarSum(void *context) {
+    bench32Vector *vector = ((ReductionBenchmarkContext *) context)->intVector;
+    int64_t sum = 0;
+    for (uint32_t i = 0; i < vector->size; i++) {
+        sum += vector->items[i];
+    }
+    benchmarkSink += (uint64_t) sum;
+}
+
+static void benchVectorSum(void *context) {
+    benchmarkSink += (uint64_t) bench32VecSum(((ReductionBenchmarkContext *) context)->intVector);
+}
+
+static void benchScalarDoubleSum(void *context) {
+    benchF64Vector *vector = ((ReductionBenchmarkContext *) context)->doubleVector;
+    double sum = 0;
+    for (uint32_t i = 0; i < vector->size; i++) {
+        sum += vector->items[i];
+    }
+    benchmarkSink += (uint64_t) sum;
+}
+
+static void benchVectorDoubleSum(void *context) {
+    benchmarkSink += (uint64_t) benchF64VecSum(((ReductionBenchmarkContext *) context)->doubleVector);
+}
+
+static void benchVectorDoubleSumCompensated(void *context) {
+    benchmarkSink += (uint64_t) benchF64VecSumCompensated(((ReductionBenchmarkContext *) context)->doubleVector);
+}
+
+static void runReductionBenchmarks() {
+    bench32Vector intVector;
+    benchF64Vector doubleVector;
+    ReductionBenchmarkContext context = {
+            .intVector = newbench32BuffVector(&intVector, malloc(sizeof(int32_t) * REDUCTION_BENCHMARK_SIZE), REDUCTION_BENCHMARK_SIZE),
+            .doubleVector = newbenchF64BuffVector(&doubleVector, malloc(sizeof(double) * REDUCTION_BENCHMARK_SIZE), REDUCTION_BENCHMARK_SIZE)
+    };
+    srand(42);
+    for (uint32_t i = 0; i < REDUCTION_BENCHMARK_SIZE; i++) {
+        bench32VecAdd(context.intVector, rand() - RAND_MAX / 2);
+        benchF64VecAdd(context.doubleVector, (double) rand() / RAND_MAX);
+    }
+
+    printBenchmarkHeader("Number vector reductions (65536 elements)");
+    runBenchmark("MinMax int32_t: scalar loop", benchScalarMinMax, &context, REDUCTION_BENCHMARK_SIZE);
+    runBenchmark("MinMax int32_t: <type>VecMinMax()", benchVectorMinMax, &context, REDUCTION_BENCHMARK_SIZE);
+    runBenchmark("Sum int32_t: scalar loop", benchScalarSum, &context, REDUCTION_BENCHMARK_SIZE);
+    runBenchmark("Sum int32_t: <type>VecSum()", benchVectorSum, &context, REDUCTION_BENCHMARK_SIZE);
+    runBenchmark("Sum double: scalar loop", benchScalarDoubleSum, &context, REDUCTION_BENCHMARK_SIZE);
+    runBenchmark("Sum double: <type>VecSum()", benchVectorDoubleSum, &context, REDUCTION_BENCHMARK_SIZE);
+    runBenchmark("Sum double: <type>VecSumCompensated()", benchVectorDoubleSumCompensated, &context, REDUCTION_BENCHMARK_SIZE);
+
+    free(context.intVector->items);
+    free(context.doubleVector->items);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "BaseBenchmarkTemplate.h"
+#include "include/BufferVector.h"
+
+#define SMALL_SORT_ARRAYS 1024
+#define SMALL_SORT_MAX_SIZE 32
+
+typedef struct SmallSortContext {
+    uint32_t size;
+    int32_t *source;    // SMALL_SORT_ARRAYS unsorted arrays of 'size' elements
+    int32_t buffer[SMALL_SORT_MAX_SIZE];
+} SmallSortContext;
+
+static int compareInt32Values(const void *one, const void *two) {
+    return int32_tComparator(*(const int32_t *) one, *(const int32_t *) two);
+}
+
+static void benchSmallQsort(void *context) {
+    SmallSortContext *ctx = context;
+    for (uint32_t i = 0; i < SMALL_SORT_ARRAYS; i++) {
+        memcpy(ctx->buffer, ctx->source + i * ctx->size, sizeof(int32_t) * ctx->size);
+        qsort(ctx->buffer, ctx->size, sizeof(int32_t), compareInt32Values);
+        benchmarkSink += (uint32_t) ctx->buffer[0];
+    }
+}
+
+static void benchSmallVectorSort(void *context) {
+    SmallSortContext *ctx = context;
+    for (uint32_t i = 0; i < SMALL_SORT_ARRAYS; i++) {
+        memcpy(ctx->buffer, ctx->source + i * ctx->size, sizeof(int32_t) * ctx->size);
+        bench32Vector *vector = newbench32BuffVectorOf(&(bench32Vector) {0}, ctx->buffer, SMALL_SORT_MAX_SIZE, ctx->size);
+        bench32VecSort(vector);
+        benchmarkSink += (uint32_t) ctx->buffer[0];
+    }
+}
+
+static void runSmallSortBenchmarks() {
+    SmallSortContext context;
+    context.source = malloc(sizeof(int32_t) * SMALL_SORT_ARRAYS * SMALL_SORT_MAX_SIZE);
+    srand(7);
+    for (uint32_t i = 0; i < SMALL_SORT_ARRAYS * SMALL_SORT_MAX_SIZE; i++) {
+        context.source[i] = rand() - RAND_MAX / 2;
+    }
+
+    printBenchmarkHeader("Small vector sort (int32_t, 1024 vectors per run)");
+    char name[64];
+    for (uint32_t size = 2; size <= SMALL_SORT_MAX_SIZE; size++) {
+        context.size = size;
+        snprintf(name, sizeof(name), "n = %2u: qsort", size);
+        runBenchmark(name, benchSmallQsort, &context, SMALL_SORT_ARRAYS * size);
+        snprintf(name, sizeof(name), "n = %2u: <type>VecSort()", size);
+        runBenchmark(name, benchSmallVectorSort, &context, SMALL_SORT_ARRAYS * size);
+    }
+    free(context.source);
+}
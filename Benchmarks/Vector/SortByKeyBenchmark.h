@@ -0,0 +1,70 @@
+#pragma once
+
+#include "BaseBenchmarkTemplate.h"
+#include "include/BufferVector.h"
+
+#define SORT_BY_KEY_SIZE 100000
+
+typedef struct BenchRecord {    // wide record, sorted by 'score'
+    int64_t id;
+    double score;
+    char payload[112];
+} BenchRecord;
+
+static int benchRecordComparator(BenchRecord one, BenchRecord two) {
+    return (one.score > two.score) - (one.score < two.score);
+}
+
+CREATE_VECTOR_TYPE(BenchRecord, benchRecord, benchRecordComparator);
+
+typedef struct SortByKeyContext {
+    BenchRecord *source;
+    benchRecordVector *vector;
+    VectorSortKey *keys;
+} SortByKeyContext;
+
+static uint64_t benchRecordKey(BenchRecord record, void *context) {
+    return vectorFloatKey(record.score);
+}
+
+static void benchRecordSort(void *context) {
+    SortByKeyContext *ctx = context;
+    memcpy(ctx->vector->items, ctx->source, sizeof(BenchRecord) * SORT_BY_KEY_SIZE);
+    benchRecordVecSort(ctx->vector);
+    benchmarkSink += (uint64_t) ctx->vector->items[0].id;
+}
+
+static void benchRecordStableSort(void *context) {
+    SortByKeyContext *ctx = context;
+    memcpy(ctx->vector->items, ctx->source, sizeof(BenchRecord) * SORT_BY_KEY_SIZE);
+    benchRecordVecStableSort(ctx->vector, NULL, 0);
+    benchmarkSink += (uint64_t) ctx->vector->items[0].id;
+}
+
+static void benchRecordSortByKey(void *context) {
+    SortByKeyContext *ctx = context;
+    memcpy(ctx->vector->items, ctx->source, sizeof(BenchRecord) * SORT_BY_KEY_SIZE);
+    benchRecordVecSortByKey(ctx->vector, benchRecordKey, NULL, ctx->keys, VECTOR_SORT_BY_KEY_LENGTH(SORT_BY_KEY_SIZE));
+    benchmarkSink += (uint64_t) ctx->vector->items[0].id;
+}
+
+static void runSortByKeyBenchmarks() {
+    benchRecordVector vector;
+    SortByKeyContext context = {
+            .source = malloc(sizeof(BenchRecord) * SORT_BY_KEY_SIZE),
+            .vector = newbenchRecordBuffVectorOf(&vector, malloc(sizeof(BenchRecord) * SORT_BY_KEY_SIZE), SORT_BY_KEY_SIZE, SORT_BY_KEY_SIZE),
+            .keys = malloc(sizeof(VectorSortKey) * VECTOR_SORT_BY_KEY_LENGTH(SORT_BY_KEY_SIZE))
+    };
+    srand(13);
+    for (int64_t i = 0; i < SORT_BY_KEY_SIZE; i++) {
+        context.source[i] = (BenchRecord) {.id = i, .score = (double) rand() / RAND_MAX - 0.5};
+    }
+
+    printBenchmarkHeader("Sort by key (128-byte records, 100000 elements)");
+    runBenchmark("<type>VecSort() with comparator", benchRecordSort, &context, SORT_BY_KEY_SIZE);
+    runBenchmark("<type>VecStableSort() without scratch", benchRecordStableSort, &context, SORT_BY_KEY_SIZE);
+    runBenchmark("<type>VecSortByKey()", benchRecordSortByKey, &context, SORT_BY_KEY_SIZE);
+    free(context.source);
+    free(context.vector->items);
+    free(context.keys);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "BaseBenchmarkTemplate.h"
+#include "include/BufferVector.h"
+
+#define STABLE_SORT_SIZE 100000
+
+typedef struct StableSortContext {
+    int32_t *source;
+    bench32Vector *vector;
+    int32_t *scratch;
+    uint32_t scratchLength;
+} StableSortContext;
+
+static void benchQsortInput(void *context) {
+    StableSortContext *ctx = context;
+    memcpy(ctx->vector->items, ctx->source, sizeof(int32_t) * STABLE_SORT_SIZE);
+    qsort(ctx->vector->items, STABLE_SORT_SIZE, sizeof(int32_t), compareInt32Values);
+    benchmarkSink += (uint32_t) ctx->vector->items[0];
+}
+
+static void benchStableSortInput(void *context) {
+    StableSortContext *ctx = context;
+    memcpy(ctx->vector->items, ctx->source, sizeof(int32_t) * STABLE_SORT_SIZE);
+    bench32VecStableSort(ctx->vector, ctx->scratch, ctx->scratchLength);
+    benchmarkSink += (uint32_t) ctx->vector->items[0];
+}
+
+static void runStableSortBenchmarks() {
+    bench32Vector vector;
+    StableSortContext context = {
+            .source = malloc(sizeof(int32_t) * STABLE_SORT_SIZE),
+            .vector = newbench32BuffVectorOf(&vector, malloc(sizeof(int32_t) * STABLE_SORT_SIZE), STABLE_SORT_SIZE, STABLE_SORT_SIZE),
+            .scratch = malloc(sizeof(int32_t) * VECTOR_STABLE_SORT_SCRATCH_LENGTH(STABLE_SORT_SIZE)),
+            .scratchLength = VECTOR_STABLE_SORT_SCRATCH_LENGTH(STABLE_SORT_SIZE)
+    };
+
+    printBenchmarkHeader("Stable sort (int32_t, 100000 elements)");
+    const char *inputs[] = {"random", "nearly sorted", "reversed"};
+    char name[64];
+    for (uint32_t input = 0; input < 3; input++) {
+        srand(11);
+        for (int32_t i = 0; i < STABLE_SORT_SIZE; i++) {
+            context.source[i] = input == 0 ? rand() : input == 1 ? i + (rand() % 100 == 0 ? rand() % 1000 : 0) : STABLE_SORT_SIZE - i;
+        }
+        snprintf(name, sizeof(name), "%s: qsort", inputs[input]);
+        runBenchmark(name, benchQsortInput, &context, STABLE_SORT_SIZE);
+        context.scratchLength = VECTOR_STABLE_SORT_SCRATCH_LENGTH(STABLE_SORT_SIZE);
+        snprintf(name, sizeof(name), "%s: <type>VecStableSort()", inputs[input]);
+        runBenchmark(name, benchStableSortInput, &context, STABLE_SORT_SIZE);
+        context.scratchLength = 0;
+        snprintf(name, sizeof(name), "%s: <type>VecStableSort() without scratch", inputs[input]);
+        runBenchmark(name, benchStableSortInput, &context, STABLE_SORT_SIZE);
+    }
+    free(context.source);
+    free(context.vector->items);
+    free(context.scratch);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "BaseBenchmarkTemplate.h"
+#include "include/ThreadPool.h"
+
+#define SCHEDULING_RANGE 1000000
+#define SCHEDULING_TASKS 10000
+
+typedef struct SchedulingContext {
+    ThreadPool pool;
+    uint32_t grain;
+} SchedulingContext;
+
+static void emptyRange(uint32_t begin, uint32_t end, void *context) {
+    benchmarkSink += end - begin;
+}
+
+static void emptyTask(void *context) {
+    benchmarkSink++;
+}
+
+static void benchParallelForOverhead(void *context) {
+    SchedulingContext *ctx = context;
+    parallelFor(ctx->pool, 0, SCHEDULING_RANGE, ctx->grain, emptyRange, NULL);
+}
+
+static void benchSubmitOverhead(void *context) {
+    SchedulingContext *ctx = context;
+    for (uint32_t i = 0; i < SCHEDULING_TASKS; i++) {
+        threadPoolSubmit(ctx->pool, emptyTask, NULL);
+    }
+    threadPoolWait(ctx->pool);
+}
+
+static void runThreadPoolBenchmarks() {
+    printBenchmarkHeader("Scheduling overhead (empty work, items are subranges or tasks)");
+    uint32_t threadCounts[] = {1, 4, 16};
+    uint32_t grains[] = {1, 64, 4096};
+    char name[64];
+    for (uint32_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++) {
+        SchedulingContext context = {.pool = getThreadPoolInstance(threadCounts[i])};
+        for (uint32_t j = 0; j < sizeof(grains) / sizeof(grains[0]); j++) {
+            context.grain = grains[j];
+            snprintf(name, sizeof(name), "%2u threads: parallelFor() grain %u", threadCounts[i], grains[j]);
+            runBenchmark(name, benchParallelForOverhead, &context, SCHEDULING_RANGE / grains[j]);
+        }
+        snprintf(name, sizeof(name), "%2u threads: threadPoolSubmit() and wait", threadCounts[i]);
+        runBenchmark(name, benchSubmitOverhead, &context, SCHEDULING_TASKS);
+        threadPoolDelete(context.pool);
+    }
+}
@@ -0,0 +1,25 @@
+#include "Vector/BulkCopyBenchmark.h"
+#include "Vector/ReductionBenchmark.h"
+#include "Vector/SmallSortBenchmark.h"
+#include "Vector/StableSortBenchmark.h"
+#include "Vector/SortByKeyBenchmark.h"
+#include "Vector/ParallelSortBenchmark.h"
+#include "Vector/ThreadPoolBenchmark.h"
+#include "Vector/ParallelSearchBenchmark.h"
+#include "Vector/ParallelSetBenchmark.h"
+#include "Vector/ConcurrentVectorBenchmark.h"
+
+
+int main() {
+    runBulkCopyBenchmarks();
+    runReductionBenchmarks();
+    runSmallSortBenchmarks();
+    runStableSortBenchmarks();
+    runSortByKeyBenchmarks();
+    runParallelSortBenchmarks();
+    runThreadPoolBenchmarks();
+    runParallelSearchBenchmarks();
+    runParallelSetBenchmarks();
+    runConcurrentVectorBenchmarks();
+    return 0;
+}
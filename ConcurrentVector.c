@@ -0,0 +1,140 @@
+#include "ConcurrentVector.h"
+#include <stdatomic.h>
+
+#define CONCURRENT_VECTOR_MAX_SEGMENTS 33   // enough for UINT32_MAX items with any first segment
+#define CACHE_LINE_SIZE 64
+
+struct ConcurrentVector {
+    _Alignas(CACHE_LINE_SIZE) atomic_ullong reserved;   // slots given to writers, 64 bits so failed adds can't wrap
+    _Alignas(CACHE_LINE_SIZE) atomic_uint published;    // every slot below is written
+    _Alignas(CACHE_LINE_SIZE) uint32_t baseShift;       // log2 of first segment capacity
+    atomic_ullong failedIndex;      // lowest slot whose segment couldn't be allocated, slots from it are never published
+    _Atomic(VectorValueType *) segments[CONCURRENT_VECTOR_MAX_SEGMENTS];    // items followed by their ready flags
+};
+
+static VectorValueType *getSegment(ConcurrentVector vector, uint32_t segment);
+static void publish(ConcurrentVector vector);
+
+
+ConcurrentVector getConcurrentVectorInstance(uint32_t firstSegmentCapacity) {
+    ConcurrentVector vector = aligned_alloc(CACHE_LINE_SIZE, sizeof(struct ConcurrentVector));
+    if (vector == NULL) return NULL;
+    atomic_init(&vector->reserved, 0);
+    atomic_init(&vector->published, 0);
+    atomic_init(&vector->failedIndex, UINT64_MAX);
+    vector->baseShift = 4;
+    while (vector->baseShift < 31 && ((uint32_t) 1 << vector->baseShift) < firstSegmentCapacity) {
+        vector->baseShift++;
+    }
+    for (uint32_t i = 0; i < CONCURRENT_VECTOR_MAX_SEGMENTS; i++) {
+        atomic_init(&vector->segments[i], NULL);
+    }
+    return vector;
+}
+
+static inline uint32_t floorLog2(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - (uint32_t) __builtin_clzll(value);
+#else
+    uint32_t log = 0;
+    while (value >>= 1) log++;
+    return log;
+#endif
+}
+
+static inline uint64_t segmentCapacity(ConcurrentVector vector, uint32_t segment) {
+    return (uint64_t) 1 << (vector->baseShift + segment);
+}
+
+// Segment k starts at index (2^k - 1) * base, so index + base has segment number in its highest bit
+static inline uint32_t locate(ConcurrentVector vector, uint32_t index, uint32_t *offset) {
+    uint64_t position = (uint64_t) index + segmentCapacity(vector, 0);
+    uint32_t segment = floorLog2(position) - vector->baseShift;
+    *offset = (uint32_t) (position - segmentCapacity(vector, segment));
+    return segment;
+}
+
+static inline atomic_uchar *readyFlags(ConcurrentVector vector, VectorValueType *items, uint32_t segment) {
+    return (atomic_uchar *) (items + segmentCapacity(vector, segment));
+}
+
+bool concurrentVectorAdd(ConcurrentVector vector, VectorValueType item) {
+    if (isConcurrentVectorFailed(vector)) return false;
+    uint64_t index = atomic_fetch_add_explicit(&vector->reserved, 1, memory_order_relaxed);
+    if (index >= UINT32_MAX) return false;
+
+    uint32_t offset;
+    uint32_t segment = locate(vector, (uint32_t) index, &offset);
+    VectorValueType *items = getSegment(vector, segment);
+    if (items == NULL) {    // slot stays empty and blocks publishing, so every later add has to fail
+        uint64_t failedIndex = atomic_load(&vector->failedIndex);
+        while (index < failedIndex && !atomic_compare_exchange_weak(&vector->failedIndex, &failedIndex, index));
+        return false;
+    }
+    items[offset] = item;
+    if (atomic_load(&vector->published) == index) {     // nobody else can publish this slot, no ready flag needed
+        atomic_store(&vector->published, (uint32_t) index + 1);
+    } else {
+        atomic_store(&readyFlags(vector, items, segment)[offset], 1);   // seq_cst pairs with check in publish()
+    }
+    publish(vector);
+    return index < atomic_load_explicit(&vector->failedIndex, memory_order_relaxed);    // best effort, failing writer may store its slot later
+}
+
+VectorValueType concurrentVectorGet(ConcurrentVector vector, uint32_t index) {
+    if (vector == NULL || index >= atomic_load_explicit(&vector->published, memory_order_acquire)) return NULL;
+    uint32_t offset;
+    uint32_t segment = locate(vector, index, &offset);
+    return atomic_load_explicit(&vector->segments[segment], memory_order_relaxed)[offset];
+}
+
+uint32_t getConcurrentVectorSize(ConcurrentVector vector) {
+    return vector != NULL ? atomic_load_explicit(&vector->published, memory_order_acquire) : 0;
+}
+
+bool isConcurrentVectorEmpty(ConcurrentVector vector) {
+    return getConcurrentVectorSize(vector) == 0;
+}
+
+bool isConcurrentVectorFailed(ConcurrentVector vector) {
+    return vector == NULL || atomic_load_explicit(&vector->failedIndex, memory_order_relaxed) != UINT64_MAX;
+}
+
+void concurrentVectorDelete(ConcurrentVector vector) {
+    if (vector == NULL) return;
+    for (uint32_t i = 0; i < CONCURRENT_VECTOR_MAX_SEGMENTS; i++) {
+        free(atomic_load_explicit(&vector->segments[i], memory_order_relaxed));
+    }
+    free(vector);
+}
+
+static VectorValueType *getSegment(ConcurrentVector vector, uint32_t segment) {    // allocated by first writer that needs it
+    VectorValueType *items = atomic_load_explicit(&vector->segments[segment], memory_order_acquire);
+    if (items != NULL) return items;
+
+    uint64_t capacity = segmentCapacity(vector, segment);
+    if (capacity * (sizeof(VectorValueType) + 1) > SIZE_MAX) return NULL;
+    VectorValueType *allocated = calloc((size_t) capacity, sizeof(VectorValueType) + 1);   // ready flags start cleared
+    if (allocated == NULL) return NULL;
+    if (!atomic_compare_exchange_strong_explicit(&vector->segments[segment], &items, allocated,
+                                                 memory_order_acq_rel, memory_order_acquire)) {
+        free(allocated);    // other writer was first, its segment is returned
+        return items;
+    }
+    return allocated;
+}
+
+// Advances published size over ready slots. Any writer can publish items of slower ones, so nobody waits for
+// predecessor. Sequentially consistent flag store and load make sure that last writer always sees ready slots
+static void publish(ConcurrentVector vector) {
+    uint32_t size = atomic_load(&vector->published);
+    while (size < UINT32_MAX) {
+        uint32_t offset;
+        uint32_t segment = locate(vector, size, &offset);
+        VectorValueType *items = atomic_load_explicit(&vector->segments[segment], memory_order_acquire);
+        if (items == NULL || !atomic_load(&readyFlags(vector, items, segment)[offset])) return;
+        if (atomic_compare_exchange_weak(&vector->published, &size, size + 1)) {
+            size++;
+        }
+    }
+}
@@ -0,0 +1,312 @@
+#include "ExternalSort.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct SortRun {
+    FILE *file;
+    uint64_t size;
+} SortRun;
+
+typedef struct MergeSource {    // run being merged, its elements are read in blocks
+    FILE *file;
+    uint8_t *block;
+    uint32_t blockCapacity;
+    uint32_t blockSize;
+    uint32_t position;
+    uint64_t remaining;         // elements left in file after current block
+} MergeSource;
+
+struct ExternalSort {
+    uint32_t elementSize;
+    size_t memoryBudget;
+    ExternalSortComparator comparator;
+    uint8_t *memory;            // run buffer during input, merge blocks after finish
+    uint32_t bufferCapacity;
+    uint32_t bufferSize;
+    uint32_t bufferPosition;    // read position when all input fits in memory
+    uint64_t size;
+    SortRun *runs;
+    uint32_t runCount;
+    uint32_t runCapacity;
+    uint32_t spilledRunCount;
+    MergeSource *sources;
+    uint32_t *heap;             // indexes of sources ordered by their current element
+    uint32_t heapSize;
+    uint8_t *outputBlock;
+    uint32_t outputCapacity;
+    bool isFinished;
+    bool isFailed;
+};
+
+static uint32_t maxMergeWays(ExternalSort sort);
+static bool spillRun(ExternalSort sort);
+static bool addRun(ExternalSort sort, FILE *file, uint64_t size);
+static bool openMerge(ExternalSort sort, uint32_t ways);
+static uint32_t readMerged(ExternalSort sort, void *items, uint32_t capacity);
+static bool mergeRuns(ExternalSort sort, uint32_t ways);
+static void closeRuns(ExternalSort sort, uint32_t count);
+
+
+ExternalSort getExternalSortInstance(uint32_t elementSize, size_t memoryBudget, ExternalSortComparator comparator) {
+    if (elementSize == 0 || comparator == NULL || memoryBudget / elementSize < 3) return NULL;   // two inputs and output
+
+    ExternalSort sort = calloc(1, sizeof(struct ExternalSort));
+    if (sort == NULL) return NULL;
+    sort->elementSize = elementSize;
+    sort->memoryBudget = memoryBudget;
+    sort->comparator = comparator;
+    sort->bufferCapacity = (memoryBudget / elementSize > UINT32_MAX) ? UINT32_MAX : (uint32_t) (memoryBudget / elementSize);
+    sort->memory = malloc((size_t) sort->bufferCapacity * elementSize);
+
+    if (sort->memory == NULL) {
+        externalSortDelete(sort);
+        return NULL;
+    }
+    return sort;
+}
+
+bool externalSortAdd(ExternalSort sort, const void *items, uint32_t count) {
+    if (sort == NULL || sort->isFinished || sort->isFailed || (items == NULL && count > 0)) return false;
+    const uint8_t *source = items;
+    while (count > 0) {
+        if (sort->bufferSize == sort->bufferCapacity && !spillRun(sort)) return false;
+        uint32_t length = sort->bufferCapacity - sort->bufferSize;
+        length = (length < count) ? length : count;
+        memcpy(sort->memory + (size_t) sort->bufferSize * sort->elementSize, source, (size_t) length * sort->elementSize);
+        sort->bufferSize += length;
+        sort->size += length;
+        source += (size_t) length * sort->elementSize;
+        count -= length;
+    }
+    return true;
+}
+
+bool externalSortFinish(ExternalSort sort) {
+    if (sort == NULL || sort->isFailed) return false;
+    if (sort->isFinished) return true;
+    sort->isFinished = true;
+    if (sort->runCount == 0) {  // everything fits in memory, no I/O
+        qsort(sort->memory, sort->bufferSize, sort->elementSize, sort->comparator);
+        return true;
+    }
+
+    if (sort->bufferSize > 0 && !spillRun(sort)) return false;
+    uint32_t ways = maxMergeWays(sort);
+    while (sort->runCount > ways) {     // intermediate passes until last merge can read every run at once
+        if (!mergeRuns(sort, ways)) return false;
+    }
+    return openMerge(sort, sort->runCount);
+}
+
+uint32_t externalSortRead(ExternalSort sort, void *items, uint32_t capacity) {
+    if (sort == NULL || items == NULL || !sort->isFinished || sort->isFailed) return 0;
+    if (sort->runCount == 0) {
+        uint32_t count = sort->bufferSize - sort->bufferPosition;
+        count = (count < capacity) ? count : capacity;
+        memcpy(items, sort->memory + (size_t) sort->bufferPosition * sort->elementSize, (size_t) count * sort->elementSize);
+        sort->bufferPosition += count;
+        return count;
+    }
+    return readMerged(sort, items, capacity);
+}
+
+bool externalSortWrite(ExternalSort sort, FILE *output) {
+    if (sort == NULL || output == NULL || !sort->isFinished || sort->isFailed) return false;
+    if (sort->runCount == 0) {
+        uint32_t count = sort->bufferSize - sort->bufferPosition;     // elements left after externalSortRead()
+        const uint8_t *items = sort->memory + (size_t) sort->bufferPosition * sort->elementSize;
+        sort->bufferPosition = sort->bufferSize;
+        if (fwrite(items, sort->elementSize, count, output) != count) {
+            sort->isFailed = true;
+            return false;
+        }
+        return true;
+    }
+
+    uint32_t count;
+    while ((count = readMerged(sort, sort->outputBlock, sort->outputCapacity)) > 0) {
+        if (fwrite(sort->outputBlock, sort->elementSize, count, output) != count) {
+            sort->isFailed = true;
+            return false;
+        }
+    }
+    return !sort->isFailed;
+}
+
+uint64_t getExternalSortSize(ExternalSort sort) {
+    return sort != NULL ? sort->size : 0;
+}
+
+uint32_t getExternalSortRunCount(ExternalSort sort) {
+    return sort != NULL ? sort->spilledRunCount : 0;
+}
+
+bool isExternalSortFailed(ExternalSort sort) {
+    return sort == NULL || sort->isFailed;
+}
+
+void externalSortDelete(ExternalSort sort) {
+    if (sort == NULL) return;
+    closeRuns(sort, sort->runCount);
+    free(sort->runs);
+    free(sort->sources);
+    free(sort->heap);
+    free(sort->memory);
+    free(sort);
+}
+
+static uint32_t maxMergeWays(ExternalSort sort) {   // every run and output needs block of at least EXTERNAL_SORT_MIN_BLOCK
+    size_t blocks = sort->memoryBudget / EXTERNAL_SORT_MIN_BLOCK;
+    if (blocks > sort->bufferCapacity) blocks = sort->bufferCapacity;     // at least one element per block
+    return (blocks > 3) ? (uint32_t) blocks - 1 : 2;
+}
+
+static bool spillRun(ExternalSort sort) {
+    qsort(sort->memory, sort->bufferSize, sort->elementSize, sort->comparator);
+    FILE *file = tmpfile();
+    if (file == NULL || fwrite(sort->memory, sort->elementSize, sort->bufferSize, file) != sort->bufferSize ||
+        fflush(file) != 0 || !addRun(sort, file, sort->bufferSize)) {
+        if (file != NULL) fclose(file);
+        sort->isFailed = true;
+        return false;
+    }
+    rewind(file);
+    sort->bufferSize = 0;
+    sort->spilledRunCount++;
+    return true;
+}
+
+static bool addRun(ExternalSort sort, FILE *file, uint64_t size) {
+    if (sort->runCount == sort->runCapacity) {
+        uint32_t capacity = (sort->runCapacity > 0) ? sort->runCapacity * 2 : 8;
+        SortRun *runs = realloc(sort->runs, sizeof(SortRun) * capacity);
+        if (runs == NULL) return false;
+        sort->runs = runs;
+        sort->runCapacity = capacity;
+    }
+    sort->runs[sort->runCount++] = (SortRun) {.file = file, .size = size};
+    return true;
+}
+
+static inline const uint8_t *sourceElement(ExternalSort sort, const MergeSource *source) {
+    return source->block + (size_t) source->position * sort->elementSize;
+}
+
+static bool fillBlock(ExternalSort sort, MergeSource *source) {     // false when run is exhausted or read failed
+    uint32_t count = (source->remaining < source->blockCapacity) ? (uint32_t) source->remaining : source->blockCapacity;
+    if (count == 0) return false;
+    if (fread(source->block, sort->elementSize, count, source->file) != count) {
+        sort->isFailed = true;
+        return false;
+    }
+    source->remaining -= count;
+    source->blockSize = count;
+    source->position = 0;
+    return true;
+}
+
+static inline bool isSourceLess(ExternalSort sort, uint32_t one, uint32_t two) {    // ties keep earlier run first
+    int result = sort->comparator(sourceElement(sort, &sort->sources[one]), sourceElement(sort, &sort->sources[two]));
+    return result < 0 || (result == 0 && one < two);
+}
+
+static void siftDown(ExternalSort sort, uint32_t root) {
+    uint32_t *heap = sort->heap;
+    uint32_t value = heap[root];
+    for (uint32_t child = 2 * root + 1; child < sort->heapSize; child = 2 * root + 1) {
+        if (child + 1 < sort->heapSize && isSourceLess(sort, heap[child + 1], heap[child])) child++;
+        if (!isSourceLess(sort, heap[child], value)) break;
+        heap[root] = heap[child];
+        root = child;
+    }
+    heap[root] = value;
+}
+
+static bool openMerge(ExternalSort sort, uint32_t ways) {   // memory is split in equal blocks for first 'ways' runs and output
+    free(sort->sources);
+    free(sort->heap);
+    sort->sources = malloc(sizeof(MergeSource) * ways);
+    sort->heap = malloc(sizeof(uint32_t) * ways);
+    if (sort->sources == NULL || sort->heap == NULL) {
+        sort->isFailed = true;
+        return false;
+    }
+
+    uint32_t blockCapacity = sort->bufferCapacity / (ways + 1);
+    sort->outputBlock = sort->memory + (size_t) blockCapacity * ways * sort->elementSize;
+    sort->outputCapacity = sort->bufferCapacity - blockCapacity * ways;
+    sort->heapSize = 0;
+    for (uint32_t i = 0; i < ways; i++) {
+        sort->sources[i] = (MergeSource) {
+                .file = sort->runs[i].file,
+                .block = sort->memory + (size_t) blockCapacity * i * sort->elementSize,
+                .blockCapacity = blockCapacity,
+                .remaining = sort->runs[i].size
+        };
+        if (fillBlock(sort, &sort->sources[i])) {
+            sort->heap[sort->heapSize++] = i;
+        }
+    }
+    for (uint32_t i = sort->heapSize / 2; i-- > 0;) {
+        siftDown(sort, i);
+    }
+    return !sort->isFailed;
+}
+
+static uint32_t readMerged(ExternalSort sort, void *items, uint32_t capacity) {
+    uint8_t *dest = items;
+    uint32_t count = 0;
+    while (count < capacity && sort->heapSize > 0) {
+        MergeSource *source = &sort->sources[sort->heap[0]];
+        memcpy(dest + (size_t) count * sort->elementSize, sourceElement(sort, source), sort->elementSize);
+        count++;
+        if (++source->position == source->blockSize && !fillBlock(sort, source)) {
+            if (sort->isFailed) return 0;
+            sort->heap[0] = sort->heap[--sort->heapSize];   // run is exhausted
+        }
+        if (sort->heapSize > 0) siftDown(sort, 0);
+    }
+    return count;
+}
+
+static bool mergeRuns(ExternalSort sort, uint32_t ways) {   // merges first runs into new run at the end of list
+    FILE *file = tmpfile();
+    if (file == NULL || !openMerge(sort, ways)) {
+        if (file != NULL) fclose(file);
+        sort->isFailed = true;
+        return false;
+    }
+
+    uint64_t size = 0;
+    uint32_t count;
+    while ((count = readMerged(sort, sort->outputBlock, sort->outputCapacity)) > 0) {
+        if (fwrite(sort->outputBlock, sort->elementSize, count, file) != count) {
+            sort->isFailed = true;      // merged run would be short even if this block was the last one
+            break;
+        }
+        size += count;
+    }
+    if (sort->isFailed || sort->heapSize > 0 || fflush(file) != 0) {
+        fclose(file);
+        sort->isFailed = true;
+        return false;
+    }
+
+    closeRuns(sort, ways);
+    if (!addRun(sort, file, size)) {
+        fclose(file);
+        sort->isFailed = true;
+        return false;
+    }
+    rewind(file);
+    return true;
+}
+
+static void closeRuns(ExternalSort sort, uint32_t count) {  // closes first runs, temporary files are removed by system
+    if (count == 0) return;
+    for (uint32_t i = 0; i < count; i++) {
+        fclose(sort->runs[i].file);
+    }
+    sort->runCount -= count;
+    memmove(sort->runs, sort->runs + count, sizeof(SortRun) * sort->runCount);
+}
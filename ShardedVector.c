@@ -0,0 +1,148 @@
+#include "ShardedVector.h"
+#include <stdlib.h>
+#include <string.h>
+#include "VectorParallel.h"
+
+#define CACHE_LINE_SIZE 64
+
+typedef struct VectorShard {    // written by owner thread only, padded to whole cache line
+    _Alignas(CACHE_LINE_SIZE) VectorValueType *items;
+    uint32_t size;
+    uint32_t capacity;
+} VectorShard;
+
+struct ShardedVector {
+    VectorShard *shards;
+    uint32_t shardCount;
+};
+
+typedef struct ShardVisit {
+    ShardedVector vector;
+    ShardFunction function;
+    void *context;
+} ShardVisit;
+
+static bool growShard(VectorShard *shard, uint32_t capacity);
+static void visitShards(uint32_t begin, uint32_t end, void *context);
+
+
+ShardedVector getShardedVectorInstance(uint32_t shardCount, uint32_t shardCapacity) {
+    if (shardCount == 0) shardCount = getOnlineCpuCount();
+    ShardedVector vector = malloc(sizeof(struct ShardedVector));
+    if (vector == NULL) return NULL;
+    vector->shardCount = shardCount;
+    vector->shards = aligned_alloc(CACHE_LINE_SIZE, sizeof(VectorShard) * shardCount);
+    if (vector->shards == NULL) {
+        free(vector);
+        return NULL;
+    }
+    memset(vector->shards, 0, sizeof(VectorShard) * shardCount);
+
+    for (uint32_t i = 0; i < shardCount && shardCapacity > 0; i++) {
+        if (!growShard(&vector->shards[i], shardCapacity)) {
+            shardedVectorDelete(vector);
+            return NULL;
+        }
+    }
+    return vector;
+}
+
+bool shardedVectorAdd(ShardedVector vector, uint32_t shard, VectorValueType item) {
+    if (vector == NULL || shard >= vector->shardCount) return false;
+    VectorShard *target = &vector->shards[shard];
+    if (target->size == target->capacity) {
+        uint32_t capacity = (target->capacity > 0) ? target->capacity * 2 : SHARDED_VECTOR_MIN_CAPACITY;
+        if (capacity <= target->capacity || !growShard(target, capacity)) return false;
+    }
+    target->items[target->size++] = item;
+    return true;
+}
+
+VectorValueType shardedVectorGet(ShardedVector vector, uint32_t shard, uint32_t index) {
+    if (vector == NULL || shard >= vector->shardCount || index >= vector->shards[shard].size) return NULL;
+    return vector->shards[shard].items[index];
+}
+
+uint32_t getShardCount(ShardedVector vector) {
+    return vector != NULL ? vector->shardCount : 0;
+}
+
+uint32_t getShardSize(ShardedVector vector, uint32_t shard) {
+    return (vector != NULL && shard < vector->shardCount) ? vector->shards[shard].size : 0;
+}
+
+uint32_t getShardedVectorSize(ShardedVector vector) {
+    uint32_t size = 0;
+    for (uint32_t i = 0; i < getShardCount(vector); i++) {
+        size += vector->shards[i].size;
+    }
+    return size;
+}
+
+bool shardedVectorCollect(ShardedVector vector, Vector dest, ThreadPool pool) {
+    if (vector == NULL || dest == NULL) return false;
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < vector->shardCount; i++) {
+        count += vector->shards[i].size;
+    }
+    uint64_t total = getVectorSize(dest) + count;   // growth is refused while 'dest' has uncommitted windows
+    if (total > UINT32_MAX || !vectorEnsureCapacity(dest, (uint32_t) total)) return false;
+
+    // One window for all shards: when uncommitted windows of 'dest' leave no room, nothing is reserved or lost
+    VectorValueType *window = vectorReserveRange(dest, (uint32_t) count);
+    if (window == NULL) return false;
+
+    for (uint32_t i = 0; i < vector->shardCount; i++) {     // shards are placed one after another, so order is kept
+        VectorShard *shard = &vector->shards[i];
+        parallelCopy(window, shard->items, shard->size, sizeof(VectorValueType), pool);    // big shards are split between threads
+        window += shard->size;
+        shard->size = 0;
+    }
+    vectorCommitRanges(dest);
+    return true;
+}
+
+void shardedVectorForEach(ShardedVector vector, ShardFunction function, void *context, ThreadPool pool) {
+    if (vector == NULL || function == NULL) return;
+    ShardVisit visit = {.vector = vector, .function = function, .context = context};
+    parallelFor(pool, 0, vector->shardCount, 1, visitShards, &visit);
+}
+
+void shardedVectorClear(ShardedVector vector) {
+    for (uint32_t i = 0; i < getShardCount(vector); i++) {
+        vector->shards[i].size = 0;
+    }
+}
+
+void shardedVectorDelete(ShardedVector vector) {
+    if (vector == NULL) return;
+    for (uint32_t i = 0; i < vector->shardCount; i++) {
+        free(vector->shards[i].items);
+    }
+    free(vector->shards);
+    free(vector);
+}
+
+static bool growShard(VectorShard *shard, uint32_t capacity) {  // item arrays start on own cache line too
+    size_t bytes = sizeof(VectorValueType) * (size_t) capacity;
+    bytes = (bytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    VectorValueType *items = aligned_alloc(CACHE_LINE_SIZE, bytes);
+    if (items == NULL) return false;
+    if (shard->size > 0) {
+        memcpy(items, shard->items, sizeof(VectorValueType) * shard->size);
+    }
+    free(shard->items);
+    shard->items = items;
+    shard->capacity = capacity;
+    return true;
+}
+
+static void visitShards(uint32_t begin, uint32_t end, void *context) {
+    ShardVisit *visit = context;
+    for (uint32_t i = begin; i < end; i++) {
+        VectorShard *shard = &visit->vector->shards[i];
+        if (shard->size > 0) {
+            visit->function(i, shard->items, shard->size, visit->context);
+        }
+    }
+}
@@ -24,6 +24,8 @@ CREATE_VECTOR_TYPE(float);
 CREATE_VECTOR_TYPE(char);
 CREATE_VECTOR_TYPE(int8_t, i8);
 CREATE_VECTOR_TYPE(uint32_t, u32);
+CREATE_VECTOR_TYPE(uint16_t, u16);
+CREATE_VECTOR_TYPE(uint16_t, u16Ref, uint16_tComparator);   // custom comparator disables counting sort
 CREATE_VECTOR_TYPE(char*, cStr, strComparator);
 CREATE_VECTOR_TYPE(char*, str, strNaturalSortComparator);
 CREATE_VECTOR_TYPE(User, user, userAgeComparator);
@@ -431,6 +433,513 @@ static MunitResult testNaturalSortTest(const MunitParameter params[], void *data
     return MUNIT_OK;
 }
 
+static MunitResult testBuffVecIntersectMany(const MunitParameter params[], void *data) {
+    intVector *intVec = VECTOR(int, 9, 1, 3, 5, 7, 3, 11);
+    intVector *intVec2 = VECTOR(int, 3, 5, 7, 9, 13);
+    intVector *intVec3 = VECTOR(int, 5, 9, 3, 2);
+    intVector *vectors[] = {intVec, intVec2, intVec3};
+
+    intVector *result = intVecIntersectMany(NEW_VECTOR_8(int), vectors, ARRAY_SIZE(vectors));  // result -> [3], [5], [9]
+    assert_not_null(result);
+    assert_uint32(intVecSize(result), ==, 3);
+    assert_int(intVecGet(result, 0), ==, 3);
+    assert_int(intVecGet(result, 1), ==, 5);
+    assert_int(intVecGet(result, 2), ==, 9);
+
+    intVector *intVec4 = VECTOR(int, 1, 2, 4);  // nothing in common with others, stops early
+    intVector *vectors2[] = {intVec, intVec2, intVec3, intVec4};
+    result = intVecIntersectMany(result, vectors2, ARRAY_SIZE(vectors2));
+    assert_not_null(result);
+    assert_true(isintVecEmpty(result));
+
+    result = intVecIntersectMany(NEW_VECTOR_8(int), vectors, 1);  // single vector, only duplicates removed
+    assert_uint32(intVecSize(result), ==, 6);
+
+    assert_null(intVecIntersectMany(NULL, vectors, ARRAY_SIZE(vectors)));
+    assert_null(intVecIntersectMany(intVec, vectors, ARRAY_SIZE(vectors)));    // destination can't be one of the sources
+    assert_null(intVecIntersectMany(NEW_VECTOR_8(int), vectors, VECTOR_MAX_MERGE_WAYS + 1));
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffVecUnionMany(const MunitParameter params[], void *data) {
+    cStrVector *strVec = VECTOR_OF(cStr, char*, "4", "1", "7");
+    cStrVector *strVec2 = VECTOR_OF(cStr, char*, "2", "4", "8", "8");
+    cStrVector *strVec3 = NEW_VECTOR_4(cStr, char*);
+    cStrVector *strVec4 = VECTOR_OF(cStr, char*, "3", "9", "1");
+    cStrVector *vectors[] = {strVec, strVec2, strVec3, strVec4};
+
+    cStrVector *result = cStrVecUnionMany(NEW_VECTOR_16(cStr, char*), vectors, ARRAY_SIZE(vectors));  // result -> [1], [2], [3], [4], [7], [8], [9]
+    assert_not_null(result);
+    assert_uint32(cStrVecSize(result), ==, 7);
+    assert_string_equal(cStrVecGet(result, 0), "1");
+    assert_string_equal(cStrVecGet(result, 1), "2");
+    assert_string_equal(cStrVecGet(result, 2), "3");
+    assert_string_equal(cStrVecGet(result, 3), "4");
+    assert_string_equal(cStrVecGet(result, 4), "7");
+    assert_string_equal(cStrVecGet(result, 5), "8");
+    assert_string_equal(cStrVecGet(result, 6), "9");
+
+    result = cStrVecUnionMany(NEW_VECTOR_4(cStr, char*), vectors, ARRAY_SIZE(vectors)); // only smallest values fit
+    assert_uint32(cStrVecSize(result), ==, 4);
+    assert_string_equal(cStrVecGet(result, 3), "4");
+
+    result = cStrVecUnionMany(NEW_VECTOR_4(cStr, char*), vectors, 0);
+    assert_true(iscStrVecEmpty(result));
+
+    assert_null(cStrVecUnionMany(NULL, vectors, ARRAY_SIZE(vectors)));
+    assert_null(cStrVecUnionMany(strVec2, vectors, ARRAY_SIZE(vectors)));
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffVecSetCounts(const MunitParameter params[], void *data) {
+    intVector *evenVec = NEW_VECTOR_64(int);
+    intVector *tripleVec = NEW_VECTOR_64(int);
+    for (int i = 49; i >= 0; i--) {  // unsorted input, will be sorted before counting
+        intVecAdd(evenVec, 2 * i - 50);     // -50 ... 48
+        intVecAdd(tripleVec, 3 * i - 60);   // -60 ... 87
+    }
+    assert_uint32(intVecIntersectCount(evenVec, tripleVec), ==, 17);   // -48, -42 ... 48
+    assert_uint32(intVecUnionCount(evenVec, tripleVec), ==, 83);
+    assert_uint32(intVecSubtractCount(evenVec, tripleVec), ==, 33);
+    assert_uint32(intVecDisjunctionCount(evenVec, tripleVec), ==, 66);
+    assert_uint32(intVecSize(evenVec), ==, 50);     // vectors are not modified, only sorted
+    assert_int(intVecGet(evenVec, 0), ==, -50);
+
+    intVector *intVec = VECTOR(int, 3, 1, 1, 2);
+    intVector *intVec2 = VECTOR(int, 1, 3, 3, 5);
+    assert_uint32(intVecIntersectCount(intVec, intVec2), ==, 2);    // [1], [3]
+    assert_uint32(intVecUnionCount(intVec, intVec2), ==, 4);        // [1], [2], [3], [5]
+    assert_uint32(intVecSubtractCount(intVec, intVec2), ==, 1);     // [2]
+    assert_uint32(intVecDisjunctionCount(intVec, intVec2), ==, 2);  // [2], [5]
+    assert_double_equal(intVecJaccard(intVec, intVec2), 0.5, 6);
+
+    u32Vector *u32Vec = VECTOR_OF(u32, uint32_t, 1, 2, 3, 4, 5, 6, 7, 4000000000u);
+    u32Vector *u32Vec2 = VECTOR_OF(u32, uint32_t, 2, 4, 6, 8, 10, 12, 4000000000u);
+    assert_uint32(u32VecIntersectCount(u32Vec, u32Vec2), ==, 4);
+    assert_uint32(u32VecUnionCount(u32Vec, u32Vec2), ==, 11);
+
+    cStrVector *strVec = VECTOR_OF(cStr, char*, "A", "B", "C", "D");
+    cStrVector *strVec2 = VECTOR_OF(cStr, char*, "C", "D", "E");
+    assert_uint32(cStrVecIntersectCount(strVec, strVec2), ==, 2);
+    assert_uint32(cStrVecDisjunctionCount(strVec, strVec2), ==, 3);
+    assert_double_equal(cStrVecJaccard(strVec, strVec2), 0.4, 6);
+
+    assert_uint32(intVecIntersectCount(NULL, intVec2), ==, 0);
+    assert_uint32(intVecUnionCount(intVec, NULL), ==, 0);
+    assert_double_equal(intVecJaccard(NEW_VECTOR_4(int), NEW_VECTOR_4(int)), 0, 6);
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffVecSetIterators(const MunitParameter params[], void *data) {
+    intVector *intVec = VECTOR(int, 1, 2, 3, 4, 5, 6);
+    intVector *intVec2 = VECTOR(int, 8, 2, 6, 4, 4);
+    intVector *intVec3 = VECTOR(int, 4, 5, 6, 7);
+
+    int value;
+    intVector *result = NEW_VECTOR_16(int);
+    assert_uint32(intVecAddFromIterator(result, VECTOR_UNION_ITERATOR(int, VECTOR_ITERATOR(int, intVec), VECTOR_ITERATOR(int, intVec2)), 16), ==, 7);
+    assert_true(isintVecEquals(result, VECTOR(int, 1, 2, 3, 4, 5, 6, 8)));
+    assert_int(intVecGet(intVec2, 0), ==, 2);   // unsorted source is sorted in place
+
+    intVecClear(result);
+    intVecAddFromIterator(result, VECTOR_INTERSECT_ITERATOR(int, VECTOR_ITERATOR(int, intVec), VECTOR_ITERATOR(int, intVec2)), 16);
+    assert_true(isintVecEquals(result, VECTOR(int, 2, 4, 6)));
+
+    intVecClear(result);
+    intVecAddFromIterator(result, VECTOR_SUBTRACT_ITERATOR(int, VECTOR_ITERATOR(int, intVec), VECTOR_ITERATOR(int, intVec2)), 16);
+    assert_true(isintVecEquals(result, VECTOR(int, 1, 3, 5)));
+
+    intVecClear(result);
+    intVecAddFromIterator(result, VECTOR_DISJUNCTION_ITERATOR(int, VECTOR_ITERATOR(int, intVec), VECTOR_ITERATOR(int, intVec2)), 16);
+    assert_true(isintVecEquals(result, VECTOR(int, 1, 3, 5, 8)));
+
+    // (intVec ∪ intVec2) ∩ intVec3 without intermediate vectors, stop after first 2 values
+    intVectorIterator *iterator = VECTOR_INTERSECT_ITERATOR(int,
+                                                          VECTOR_UNION_ITERATOR(int, VECTOR_ITERATOR(int, intVec), VECTOR_ITERATOR(int, intVec2)),
+                                                          VECTOR_ITERATOR(int, intVec3));
+    intVecClear(result);
+    assert_uint32(intVecAddFromIterator(result, iterator, 2), ==, 2);
+    assert_true(isintVecEquals(result, VECTOR(int, 4, 5)));
+    assert_true(intVecIteratorNext(iterator, &value));
+    assert_int(value, ==, 6);
+    assert_false(intVecIteratorNext(iterator, &value));
+    assert_false(intVecIteratorNext(iterator, &value));
+
+    cStrVector *strVec = VECTOR_OF(cStr, char*, "b", "a", "c");
+    cStrVectorIterator *strIterator = VECTOR_SUBTRACT_ITERATOR(cStr, VECTOR_ITERATOR(cStr, strVec), VECTOR_ITERATOR(cStr, NEW_VECTOR_4(cStr, char*)));
+    char *strValue;
+    assert_true(cStrVecIteratorNext(strIterator, &strValue));
+    assert_string_equal(strValue, "a");
+
+    assert_null(VECTOR_ITERATOR(int, NULL));
+    assert_null(VECTOR_UNION_ITERATOR(int, NULL, VECTOR_ITERATOR(int, intVec)));
+    assert_false(intVecIteratorNext(NULL, &value));
+    return MUNIT_OK;
+}
+
+static bool isEvenInt(int item, void *context) {
+    return item % 2 == 0;
+}
+
+static bool isUserOlderThan(User user, void *context) {
+    return user.age > *((int *) context);
+}
+
+static MunitResult testBuffVecRemoveRetainIf(const MunitParameter params[], void *data) {
+    intVector *intVec = VECTOR(int, 1, 2, 3, 4, 5, 6, 7);
+    intVecRemoveIf(intVec, isEvenInt, NULL);    // [1], [3], [5], [7]
+    assert_true(isintVecEquals(intVec, VECTOR(int, 1, 3, 5, 7)));
+
+    intVector *intVec2 = VECTOR(int, 1, 2, 3, 4, 5, 6, 7);
+    intVecRetainIf(intVec2, isEvenInt, NULL);   // [2], [4], [6]
+    assert_true(isintVecEquals(intVec2, VECTOR(int, 2, 4, 6)));
+
+    assert_null(intVecRemoveIf(NULL, isEvenInt, NULL));
+    assert_null(intVecRetainIf(intVec, NULL, NULL));
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffVecPartition(const MunitParameter params[], void *data) {
+    intVector *intVec = VECTOR(int, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+    uint32_t count = intVecPartition(intVec, isEvenInt, NULL);
+    assert_uint32(count, ==, 4);
+    for (uint32_t i = 0; i < intVecSize(intVec); i++) {
+        assert_int(intVecGet(intVec, i) % 2 == 0, ==, i < count);
+    }
+
+    int age = 30;
+    userVector *uVec = VECTOR_OF(user, User, {"A", 40}, {"B", 20}, {"C", 35}, {"D", 25}, {"E", 50}, {"F", 10});
+    assert_uint32(userVecStablePartition(uVec, isUserOlderThan, &age, NULL, 0), ==, 3);   // in place
+    const char *expected[] = {"A", "C", "E", "B", "D", "F"};
+    for (uint32_t i = 0; i < ARRAY_SIZE(expected); i++) {
+        assert_string_equal(userVecGet(uVec, i).name, expected[i]);
+    }
+
+    User scratch[6];
+    age = 20;
+    assert_uint32(userVecStablePartition(uVec, isUserOlderThan, &age, scratch, ARRAY_SIZE(scratch)), ==, 4);
+    const char *expected2[] = {"A", "C", "E", "D", "B", "F"};
+    for (uint32_t i = 0; i < ARRAY_SIZE(expected2); i++) {
+        assert_string_equal(userVecGet(uVec, i).name, expected2[i]);
+    }
+
+    assert_uint32(intVecPartition(NULL, isEvenInt, NULL), ==, 0);
+    assert_uint32(intVecStablePartition(intVec, NULL, NULL, NULL, 0), ==, 0);
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffVecBulkOperations(const MunitParameter params[], void *data) {
+    intVector *intVec = NEW_VECTOR_OF(8, int, int, 1, 2, 3);
+    assert_false(intVecAddAt(intVec, 4, 10));   // index after last element, no gaps allowed
+    assert_true(intVecAddAt(intVec, 3, 4));
+    assert_false(intVecAddAll(intVec, VECTOR(int, 5, 6, 7, 8, 9)));  // doesn't fit, nothing added
+    assert_uint32(intVecSize(intVec), ==, 4);
+    assert_true(intVecAddAll(intVec, VECTOR(int, 5, 6, 7, 8)));
+    assert_true(isintVecEquals(intVec, VECTOR(int, 1, 2, 3, 4, 5, 6, 7, 8)));
+
+    assert_int(intVecRemoveAt(intVec, 7), ==, 8);
+    assert_int(intVecRemoveAt(intVec, 7), ==, 0);   // index after last element
+    assert_uint32(intVecSize(intVec), ==, 7);
+
+    intVecReset(intVec);
+    assert_true(isintVecEmpty(intVec));
+    assert_int(intVec->items[0], ==, 1);    // buffer is left as is
+
+    int array[] = {9, 8, 7, 6, 5, 4, 3, 2, 1, 0};
+    intVecFromArray(intVec, array, ARRAY_SIZE(array));  // only first 8 values fit
+    assert_uint32(intVecSize(intVec), ==, 8);
+    assert_int(intVecGet(intVec, 7), ==, 2);
+    assert_null(intVecFromArray(NULL, array, ARRAY_SIZE(array)));
+
+    intVecClear(intVec);
+    assert_int(intVec->items[0], ==, 0);
+    return MUNIT_OK;
+}
+
+static void fillNarrowVectors(u16Vector *vector, u16RefVector *reference, uint32_t count, uint32_t seed, uint16_t range) {
+    u16VecClear(vector);
+    u16RefVecClear(reference);
+    for (uint32_t i = 0; i < count; i++) {
+        uint16_t value = (uint16_t) (((i + seed) * 2654435761u >> 7) % range);
+        u16VecAdd(vector, value);
+        u16RefVecAdd(reference, value);
+    }
+}
+
+static bool isNarrowEqual(u16Vector *vector, u16RefVector *reference) {
+    if (u16VecSize(vector) != u16RefVecSize(reference)) return false;
+    return memcmp(vector->items, reference->items, sizeof(uint16_t) * vector->size) == 0;
+}
+
+static MunitResult testBuffVecCountingSort(const MunitParameter params[], void *data) {
+    u16Vector *first = NEW_VECTOR_1024(u16, uint16_t);
+    u16Vector *second = NEW_VECTOR_1024(u16, uint16_t);
+    u16RefVector *firstRef = NEW_VECTOR_1024(u16Ref, uint16_t);
+    u16RefVector *secondRef = NEW_VECTOR_1024(u16Ref, uint16_t);
+    uint16_t ranges[] = {5, 200, 1500, 65535};  // stack counters, heap counters and comparison sort of wide range
+
+    for (uint32_t r = 0; r < ARRAY_SIZE(ranges); r++) {
+        fillNarrowVectors(first, firstRef, 400, 0, ranges[r]);
+        assert_true(isNarrowEqual(u16VecSort(first), u16RefVecSort(firstRef)));
+        fillNarrowVectors(first, firstRef, 400, 0, ranges[r]);
+        assert_true(isNarrowEqual(u16VecRemoveDup(first), u16RefVecRemoveDup(firstRef)));
+
+        fillNarrowVectors(first, firstRef, 400, 0, ranges[r]);
+        fillNarrowVectors(second, secondRef, 300, 77, ranges[r]);
+        assert_true(isNarrowEqual(u16VecIntersect(first, second), u16RefVecIntersect(firstRef, secondRef)));
+        fillNarrowVectors(first, firstRef, 400, 0, ranges[r]);
+        fillNarrowVectors(second, secondRef, 300, 77, ranges[r]);
+        assert_true(isNarrowEqual(u16VecSubtract(first, second), u16RefVecSubtract(firstRef, secondRef)));
+        fillNarrowVectors(first, firstRef, 400, 0, ranges[r]);
+        fillNarrowVectors(second, secondRef, 300, 77, ranges[r]);
+        assert_true(isNarrowEqual(u16VecDisjunction(first, second), u16RefVecDisjunction(firstRef, secondRef)));
+    }
+
+    i8Vector *signedVec = NEW_VECTOR_OF(8, i8, int8_t, 5, -128, 127, 0, -1, 5, -128, 3);
+    i8VecRemoveDup(signedVec);
+    assert_true(isi8VecEquals(signedVec, NEW_VECTOR_OF(6, i8, int8_t, -128, -1, 0, 3, 5, 127)));
+    u16Vector *wideVec = NEW_VECTOR_64(u16, uint16_t);
+    for (uint32_t i = 0; i < 40; i++) {
+        u16VecAdd(wideVec, (i % 2 == 0) ? 65535 : 0);   // two values, but range is too wide for counters
+    }
+    u16VecRemoveDup(wideVec);
+    assert_true(isu16VecEquals(wideVec, NEW_VECTOR_OF(2, u16, uint16_t, 0, 65535)));
+    charVector *charVec = VECTOR(char, 'd', 'a', 'c', 'a', 'b');
+    assert_true(ischarVecEquals(charVecSort(charVec), VECTOR(char, 'a', 'a', 'b', 'c', 'd')));
+    return MUNIT_OK;
+}
+
+static bool isNegativeZero(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(float));
+    return bits == 0x80000000u;
+}
+
+static int compareIntValues(const void *one, const void *two) {
+    return intComparator(*(const int *) one, *(const int *) two);
+}
+
+static MunitResult testBuffVecSmallSort(const MunitParameter params[], void *data) {
+    for (uint32_t size = 0; size <= 40; size++) {   // kernel, network, insertion sort and qsort sizes
+        for (uint32_t seed = 0; seed < 20; seed++) {
+            intVector *intVec = NEW_VECTOR_64(int);
+            u32Vector *u32Vec = NEW_VECTOR_64(u32, uint32_t);
+            floatVector *flVec = NEW_VECTOR_64(float);
+            userVector *userVec = NEW_VECTOR_64(user, User);
+            int expected[64];
+            for (uint32_t i = 0; i < size; i++) {
+                int value = (int) (((i + 1) * 2654435761u ^ seed * 40503u) % 61) - 30;   // repeats and negative values
+                expected[i] = value;
+                intVecAdd(intVec, value);
+                u32VecAdd(u32Vec, (uint32_t) value);    // negative values become largest
+                floatVecAdd(flVec, (float) value / 2);
+                userVecAdd(userVec, (User) {.name = "user", .age = value});
+            }
+            qsort(expected, size, sizeof(int), compareIntValues);
+
+            intVecSort(intVec);
+            floatVecSort(flVec);
+            userVecSort(userVec);
+            u32VecSort(u32Vec);
+            for (uint32_t i = 0; i < size; i++) {
+                assert_int(intVecGet(intVec, i), ==, expected[i]);
+                assert_float(floatVecGet(flVec, i), ==, (float) expected[i] / 2);
+                assert_int(userVecGet(userVec, i).age, ==, expected[i]);
+                if (i > 0) {
+                    assert_uint32(u32VecGet(u32Vec, i - 1), <=, u32VecGet(u32Vec, i));
+                }
+            }
+        }
+    }
+
+    floatVector *zeroVec = VECTOR(float, 0.0f, -0.0f, 1.0f, -0.0f);     // signed zeros keep their bits
+    floatVecSort(zeroVec);
+    assert_int(isNegativeZero(floatVecGet(zeroVec, 0)) + isNegativeZero(floatVecGet(zeroVec, 1)) + isNegativeZero(floatVecGet(zeroVec, 2)), ==, 2);
+    assert_float(floatVecGet(zeroVec, 3), ==, 1.0f);
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffVecStableSort(const MunitParameter params[], void *data) {
+    static char insertionOrder[1000];     // name pointer tells insertion index
+    userVector *userVec = NEW_VECTOR_1024(user, User);
+    userVector *inPlaceVec = NEW_VECTOR_1024(user, User);
+    for (uint32_t i = 0; i < 1000; i++) {
+        User user = {.name = &insertionOrder[i], .age = (int) ((i * 7919) % 13)};     // many equal ages
+        userVecAdd(userVec, user);
+        userVecAdd(inPlaceVec, user);
+    }
+
+    User scratch[VECTOR_STABLE_SORT_SCRATCH_LENGTH(1000)];
+    assert_ptr_equal(userVecStableSort(userVec, scratch, ARRAY_SIZE(scratch)), userVec);
+    userVecStableSort(inPlaceVec, NULL, 0);     // no scratch, merges by rotation
+    for (uint32_t i = 1; i < 1000; i++) {
+        User previous = userVecGet(userVec, i - 1);
+        User current = userVecGet(userVec, i);
+        assert_int(previous.age, <=, current.age);
+        if (previous.age == current.age) {
+            assert_ptr(previous.name, <, current.name);
+        }
+        assert_int(userVecGet(inPlaceVec, i).age, ==, current.age);
+        assert_ptr_equal(userVecGet(inPlaceVec, i).name, current.name);
+    }
+
+    intVector *intVec = NEW_VECTOR_1024(int);
+    for (int i = 0; i < 1000; i++) {
+        intVecAdd(intVec, (i < 500) ? 1000 - i : i);    // descending run followed by ascending run
+    }
+    intVecStableSort(intVec, NULL, 0);
+    for (uint32_t i = 1; i < 1000; i++) {
+        assert_int(intVecGet(intVec, i - 1), <=, intVecGet(intVec, i));
+    }
+    assert_null(intVecStableSort(NULL, NULL, 0));
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffVecSelection(const MunitParameter params[], void *data) {
+    int expected[1000];
+    for (uint32_t pattern = 0; pattern < 4; pattern++) {     // random, sorted, all equal, organ pipe
+        intVector *intVec = NEW_VECTOR_1024(int);
+        for (uint32_t i = 0; i < 1000; i++) {
+            int value = (pattern == 0) ? (int) ((i * 2654435761u) % 997) - 500 :
+                        (pattern == 1) ? (int) i :
+                        (pattern == 2) ? 7 : (int) (i < 500 ? i : 1000 - i);
+            expected[i] = value;
+            intVecAdd(intVec, value);
+        }
+        qsort(expected, 1000, sizeof(int), compareIntValues);
+
+        assert_int(intVecNthElement(intVec, 500), ==, expected[500]);
+        for (uint32_t i = 0; i < 1000; i++) {
+            assert_true(i > 500 ? intVecGet(intVec, i) >= expected[500] : intVecGet(intVec, i) <= expected[500]);
+        }
+        intVecPartialSort(intVec, 10);
+        for (uint32_t i = 0; i < 10; i++) {
+            assert_int(intVecGet(intVec, i), ==, expected[i]);
+        }
+        intVecTopK(intVec, 10);
+        for (uint32_t i = 0; i < 10; i++) {
+            assert_int(intVecGet(intVec, i), ==, expected[999 - i]);
+        }
+
+        uint32_t ranks[] = {0, 10, 10, 250, 500, 990, 999};
+        assert_true(intVecSelectRanks(intVec, ranks, ARRAY_SIZE(ranks)));
+        for (uint32_t i = 0; i < ARRAY_SIZE(ranks); i++) {
+            assert_int(intVecGet(intVec, ranks[i]), ==, expected[ranks[i]]);
+        }
+        double quantiles[] = {0.99, 0.5, 0.0, 0.9, 1.0};
+        int results[ARRAY_SIZE(quantiles)];
+        assert_true(intVecQuantiles(intVec, quantiles, results, ARRAY_SIZE(quantiles)));
+        for (uint32_t i = 0; i < ARRAY_SIZE(quantiles); i++) {
+            assert_int(results[i], ==, expected[(uint32_t) (quantiles[i] * 999 + 0.5)]);
+        }
+    }
+
+    userVector *userVec = NEW_VECTOR_OF(8, user, User, {"a", 30}, {"b", 10}, {"c", 20}, {"d", 40});
+    assert_int(userVecNthElement(userVec, 1).age, ==, 20);
+    userVecTopK(userVec, 2);
+    assert_string_equal(userVecGet(userVec, 0).name, "d");
+    assert_string_equal(userVecGet(userVec, 1).name, "a");
+
+    uint32_t unordered[] = {3, 1};
+    double invalid[] = {1.5};
+    int result;
+    assert_false(userVecSelectRanks(userVec, unordered, ARRAY_SIZE(unordered)));
+    assert_false(intVecQuantiles(VECTOR(int, 1, 2), invalid, &result, 1));
+    assert_false(intVecQuantiles(NEW_VECTOR(int, 1), (double[]) {0.5}, &result, 1));
+    assert_false(intVecQuantiles(VECTOR(int, 1, 2), NULL, &result, 1));
+    assert_false(intVecQuantiles(VECTOR(int, 1, 2), (double[]) {0.5}, NULL, 1));
+    assert_int(intVecNthElement(VECTOR(int, 1), 1), ==, 0);
+    assert_null(intVecTopK(NULL, 1));
+    assert_true(isintVecEquals(intVecTopK(VECTOR(int, 1, 9, 3, 4), 0), VECTOR(int, 1, 9, 3, 4)));
+    return MUNIT_OK;
+}
+
+static MunitResult testBuffVecArgSort(const MunitParameter params[], void *data) {
+    static char insertionOrder[1000];
+    userVector *userVec = NEW_VECTOR_1024(user, User);
+    intVector *idVec = NEW_VECTOR_1024(int);
+    floatVector *scoreVec = NEW_VECTOR_1024(float);
+    for (uint32_t i = 0; i < 1000; i++) {     // parallel columns of one table
+        userVecAdd(userVec, (User) {.name = &insertionOrder[i], .age = (int) ((i * 7919) % 13)});
+        intVecAdd(idVec, (int) i);
+        floatVecAdd(scoreVec, (float) i / 4);
+    }
+
+    uint32_t indexes[VECTOR_ARG_SORT_LENGTH(1000)];
+    assert_true(userVecArgSort(userVec, indexes, ARRAY_SIZE(indexes)));
+    userVector *sortedUsers = NEW_VECTOR_1024(user, User);
+    intVector *sortedIds = NEW_VECTOR_1024(int);
+    floatVector *sortedScores = NEW_VECTOR_1024(float);
+    assert_true(userVecGather(sortedUsers, userVec, indexes, 1000));
+    assert_true(intVecGather(sortedIds, idVec, indexes, 1000));
+    assert_true(floatVecGather(sortedScores, scoreVec, indexes, 1000));
+    for (uint32_t i = 1; i < 1000; i++) {
+        User previous = userVecGet(sortedUsers, i - 1);
+        User current = userVecGet(sortedUsers, i);
+        assert_int(previous.age, <=, current.age);
+        if (previous.age == current.age) {
+            assert_ptr(previous.name, <, current.name);     // stable
+        }
+        assert_ptr_equal(current.name, &insertionOrder[intVecGet(sortedIds, i)]);
+        assert_float(floatVecGet(sortedScores, i), ==, (float) intVecGet(sortedIds, i) / 4);
+    }
+
+    intVector *restoredIds = NEW_VECTOR_1024(int);
+    assert_true(intVecScatter(restoredIds, sortedIds, indexes));     // scatter is inverse of gather
+    assert_true(isintVecEquals(restoredIds, idVec));
+
+    assert_false(userVecArgSort(userVec, indexes, 1999));
+    assert_false(intVecGather(NEW_VECTOR(int, 2), idVec, indexes, 3));
+    assert_false(intVecGather(sortedIds, VECTOR(int, 1, 2), (uint32_t[]) {0, 2}, 2));
+    assert_false(intVecScatter(NEW_VECTOR(int, 2), VECTOR(int, 1), (uint32_t[]) {2}));
+    assert_false(intVecGather(idVec, idVec, indexes, 10));
+    return MUNIT_OK;
+}
+
+static uint64_t userAgeKey(User user, void *context) {
+    return vectorSignedKey(user.age);
+}
+
+static uint64_t floatKey(float value, void *context) {
+    return vectorFloatKey(value);
+}
+
+static MunitResult testBuffVecSortByKey(const MunitParameter params[], void *data) {
+    static char insertionOrder[1000];
+    userVector *userVec = NEW_VECTOR_1024(user, User);
+    userVector *expectedVec = NEW_VECTOR_1024(user, User);
+    floatVector *floatVec = NEW_VECTOR_1024(float);
+    floatVector *expectedFloatVec = NEW_VECTOR_1024(float);
+    for (uint32_t i = 0; i < 1000; i++) {
+        User user = {.name = &insertionOrder[i], .age = (int) ((i * 7919) % 301) - 150};     // negative ages and repeats
+        userVecAdd(userVec, user);
+        userVecAdd(expectedVec, user);
+        floatVecAdd(floatVec, (float) user.age / 3);
+        floatVecAdd(expectedFloatVec, (float) user.age / 3);
+    }
+
+    VectorSortKey keys[VECTOR_SORT_BY_KEY_LENGTH(1000)];
+    assert_ptr_equal(userVecSortByKey(userVec, userAgeKey, NULL, keys, ARRAY_SIZE(keys)), userVec);
+    userVecStableSort(expectedVec, NULL, 0);
+    for (uint32_t i = 0; i < 1000; i++) {
+        assert_int(userVecGet(userVec, i).age, ==, userVecGet(expectedVec, i).age);
+        assert_ptr_equal(userVecGet(userVec, i).name, userVecGet(expectedVec, i).name);    // stable
+    }
+
+    floatVecSortByKey(floatVec, floatKey, NULL, keys, ARRAY_SIZE(keys));
+    assert_true(isfloatVecEquals(floatVec, floatVecSort(expectedFloatVec)));
+
+    userVector *smallVec = NEW_VECTOR_OF(4, user, User, {"a", 3}, {"b", -1}, {"c", 3}, {"d", 0});
+    userVecSortByKey(smallVec, userAgeKey, NULL, keys, 8);
+    assert_string_equal(userVecGet(smallVec, 0).name, "b");
+    assert_string_equal(userVecGet(smallVec, 1).name, "d");
+    assert_string_equal(userVecGet(smallVec, 2).name, "a");
+    assert_string_equal(userVecGet(smallVec, 3).name, "c");
+    assert_null(userVecSortByKey(smallVec, userAgeKey, NULL, keys, 7));
+    assert_null(userVecSortByKey(smallVec, NULL, NULL, keys, 8));
+    return MUNIT_OK;
+}
+
 
 static MunitTest bufferVectorTests[] = {
         {.name =  "Test new Vector - should correctly create and init vector", .test = testBuffVecCreation},
@@ -454,6 +963,19 @@ static MunitTest bufferVectorTests[] = {
         {.name =  "Test <type>VecSubtract() - should correctly subtract two vectors", .test = testBuffVecSubtract},
         {.name =  "Test <type>VecDisjunction() - should correctly make disjunction of two vectors", .test = testBuffVecDisjunction},
         {.name =  "Test strNaturalSortComparator() - should correctly sort string in natural order", .test = testNaturalSortTest},
+        {.name =  "Test <type>VecIntersectMany() - should correctly intersect multiple vectors", .test = testBuffVecIntersectMany},
+        {.name =  "Test <type>VecUnionMany() - should correctly union multiple vectors", .test = testBuffVecUnionMany},
+        {.name =  "Test <type>Vec<Operation>Count() - should correctly count set operation results", .test = testBuffVecSetCounts},
+        {.name =  "Test <type>Vec<Operation>Iterator() - should lazily iterate set operation results", .test = testBuffVecSetIterators},
+        {.name =  "Test <type>VecRemoveIf/RetainIf() - should correctly filter vector by predicate", .test = testBuffVecRemoveRetainIf},
+        {.name =  "Test <type>VecPartition/StablePartition() - should move matching elements to front", .test = testBuffVecPartition},
+        {.name =  "Test <type>VecAddAll/FromArray/AddAt/RemoveAt/Reset() - should correctly copy element blocks", .test = testBuffVecBulkOperations},
+        {.name =  "Test <type>VecSort/RemoveDup/Intersect/Subtract/Disjunction() - counting pass should match comparator result", .test = testBuffVecCountingSort},
+        {.name =  "Test <type>VecSort() - should sort small vectors with networks and insertion sort", .test = testBuffVecSmallSort},
+        {.name =  "Test <type>VecStableSort() - should keep insertion order of equal items", .test = testBuffVecStableSort},
+        {.name =  "Test <type>VecNthElement()/TopK()/Quantiles() - should select order statistics", .test = testBuffVecSelection},
+        {.name =  "Test <type>VecArgSort()/Gather()/Scatter() - should reorder parallel columns", .test = testBuffVecArgSort},
+        {.name =  "Test <type>VecSortByKey() - should sort by extracted keys", .test = testBuffVecSortByKey},
 
         END_OF_TESTS
 };
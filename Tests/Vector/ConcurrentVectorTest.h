@@ -0,0 +1,106 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "ConcurrentVector.h"
+#include "ThreadPool.h"
+
+#define CONCURRENT_TEST_WRITERS 4
+#define CONCURRENT_TEST_ITEMS 50000
+
+typedef struct ConcurrentWriter {
+    ConcurrentVector vector;
+    uint32_t index;
+    uint32_t isReader;      // checks published prefix while writers append
+    uint32_t *writersDone;
+    uint32_t readerChecks;
+} ConcurrentWriter;
+
+static void appendItems(void *context) {
+    ConcurrentWriter *writer = context;
+    if (writer->isReader) {
+        while (__atomic_load_n(writer->writersDone, __ATOMIC_ACQUIRE) < CONCURRENT_TEST_WRITERS) {
+            uint32_t size = getConcurrentVectorSize(writer->vector);
+            for (uint32_t i = (size > 100) ? size - 100 : 0; i < size; i++) {
+                assert_not_null(concurrentVectorGet(writer->vector, i));   // published items are always written
+            }
+            writer->readerChecks++;
+        }
+        return;
+    }
+    for (uint32_t i = 0; i < CONCURRENT_TEST_ITEMS; i++) {
+        uintptr_t value = (uintptr_t) writer->index * CONCURRENT_TEST_ITEMS + i + 1;
+        assert_true(concurrentVectorAdd(writer->vector, (VectorValueType) value));
+    }
+    __atomic_fetch_add(writer->writersDone, 1, __ATOMIC_RELEASE);
+}
+
+static MunitResult testConcurrentVectorAdd(const MunitParameter params[], void *data) {
+    ConcurrentVector vector = getConcurrentVectorInstance(10);   // rounded up to 16
+    assert_not_null(vector);
+    assert_true(isConcurrentVectorEmpty(vector));
+    assert_null(concurrentVectorGet(vector, 0));
+    for (uintptr_t i = 1; i <= 1000; i++) {     // crosses several segments
+        assert_true(concurrentVectorAdd(vector, (VectorValueType) i));
+    }
+    assert_uint32(getConcurrentVectorSize(vector), ==, 1000);
+    for (uint32_t i = 0; i < 1000; i++) {
+        assert_ptr_equal(concurrentVectorGet(vector, i), (VectorValueType) (uintptr_t) (i + 1));
+    }
+    assert_null(concurrentVectorGet(vector, 1000));
+    assert_false(isConcurrentVectorFailed(vector));
+    concurrentVectorDelete(vector);
+
+    assert_false(concurrentVectorAdd(NULL, NULL));
+    assert_true(isConcurrentVectorFailed(NULL));
+    assert_uint32(getConcurrentVectorSize(NULL), ==, 0);
+    return MUNIT_OK;
+}
+
+static MunitResult testConcurrentVectorWriters(const MunitParameter params[], void *data) {
+    ConcurrentVector vector = getConcurrentVectorInstance(0);
+    ThreadPool pool = getThreadPoolInstance(CONCURRENT_TEST_WRITERS + 1);
+    uint32_t writersDone = 0;
+    ConcurrentWriter writers[CONCURRENT_TEST_WRITERS + 1];
+    for (uint32_t i = 0; i <= CONCURRENT_TEST_WRITERS; i++) {
+        writers[i] = (ConcurrentWriter) {.vector = vector, .index = i, .isReader = i == CONCURRENT_TEST_WRITERS, .writersDone = &writersDone};
+        if (!threadPoolSubmit(pool, appendItems, &writers[i])) {
+            appendItems(&writers[i]);   // threads are disabled, reader runs last and sees all writers done
+        }
+    }
+    threadPoolWait(pool);
+    threadPoolDelete(pool);
+
+    uint32_t total = CONCURRENT_TEST_WRITERS * CONCURRENT_TEST_ITEMS;
+    assert_uint32(getConcurrentVectorSize(vector), ==, total);
+    uint8_t *isSeen = calloc(total + 1, 1);
+    uint32_t *lastOfWriter = calloc(CONCURRENT_TEST_WRITERS, sizeof(uint32_t));
+    for (uint32_t i = 0; i < total; i++) {
+        uintptr_t value = (uintptr_t) concurrentVectorGet(vector, i);
+        assert_uint32(value, >=, 1);
+        assert_uint32(value, <=, total);
+        assert_uint32(isSeen[value], ==, 0);    // every item once
+        isSeen[value] = 1;
+        uint32_t writer = (uint32_t) ((value - 1) / CONCURRENT_TEST_ITEMS);
+        assert_uint32(value, >, lastOfWriter[writer]);  // items of one writer keep their order
+        lastOfWriter[writer] = (uint32_t) value;
+    }
+    free(isSeen);
+    free(lastOfWriter);
+    concurrentVectorDelete(vector);
+    return MUNIT_OK;
+}
+
+static MunitTest concurrentVectorTests[] = {
+        {.name =  "Test concurrentVectorAdd() - should publish items in segments", .test = testConcurrentVectorAdd},
+        {.name =  "Test concurrentVectorAdd() - should keep every item of concurrent writers", .test = testConcurrentVectorWriters},
+
+        END_OF_TESTS
+};
+
+static const MunitSuite concurrentVectorTestSuite = {
+        .prefix = "ConcurrentVector: ",
+        .tests = concurrentVectorTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "BufferVector.h"
+#include "ExternalSort.h"
+#if defined(__unix__)
+#include <signal.h>
+#include <sys/resource.h>
+#endif
+
+#define EXTERNAL_SORT_TEST_SIZE 100000
+
+CREATE_VECTOR_TYPE(uint32_t, extSort);
+
+static int compareUInt32Values(const void *one, const void *two) {
+    return uint32_tComparator(*(const uint32_t *) one, *(const uint32_t *) two);
+}
+
+static ExternalSort newFilledExternalSort(size_t memoryBudget) {
+    ExternalSort sort = getExternalSortInstance(sizeof(uint32_t), memoryBudget, compareUInt32Values);
+    assert_not_null(sort);
+    uint32_t chunk[1000];
+    for (uint32_t i = 0; i < EXTERNAL_SORT_TEST_SIZE; i += ARRAY_SIZE(chunk)) {  // input is streamed in chunks
+        for (uint32_t j = 0; j < ARRAY_SIZE(chunk); j++) {
+            chunk[j] = ((i + j) * 7919) % EXTERNAL_SORT_TEST_SIZE / 2;     // shuffled, every value twice
+        }
+        assert_true(externalSortAdd(sort, chunk, ARRAY_SIZE(chunk)));
+    }
+    assert_true(externalSortFinish(sort));
+    assert_uint64(getExternalSortSize(sort), ==, EXTERNAL_SORT_TEST_SIZE);
+    return sort;
+}
+
+static void assertSortedChunks(ExternalSort sort) {
+    extSortVector *vector = NEW_VECTOR_1024(extSort, uint32_t);
+    uint32_t total = 0;
+    while ((vector->size = externalSortRead(sort, vector->items, vector->capacity)) > 0) {   // fills BufferVector
+        for (uint32_t i = 0; i < vector->size; i++, total++) {
+            assert_uint32(extSortVecGet(vector, i), ==, total / 2);
+        }
+    }
+    assert_uint32(total, ==, EXTERNAL_SORT_TEST_SIZE);
+    assert_false(isExternalSortFailed(sort));
+}
+
+static MunitResult testExternalSortRead(const MunitParameter params[], void *data) {
+    ExternalSort sort = newFilledExternalSort(16 * 1024);     // 25 runs, merged in several passes
+    assert_uint32(getExternalSortRunCount(sort), ==, 25);
+    assertSortedChunks(sort);
+    externalSortDelete(sort);
+
+    sort = newFilledExternalSort(EXTERNAL_SORT_MIN_BLOCK * 4);    // single merge pass
+    assert_uint32(getExternalSortRunCount(sort), ==, 2);
+    assertSortedChunks(sort);
+    externalSortDelete(sort);
+
+    sort = newFilledExternalSort(EXTERNAL_SORT_TEST_SIZE * sizeof(uint32_t));    // fits in memory
+    assert_uint32(getExternalSortRunCount(sort), ==, 0);
+    assertSortedChunks(sort);
+    externalSortDelete(sort);
+    return MUNIT_OK;
+}
+
+static MunitResult testExternalSortWrite(const MunitParameter params[], void *data) {
+    ExternalSort sort = newFilledExternalSort(16 * 1024);
+    FILE *output = tmpfile();
+    assert_not_null(output);
+    assert_true(externalSortWrite(sort, output));
+    assert_false(externalSortAdd(sort, (uint32_t[]) {1}, 1));     // sort is finished
+    externalSortDelete(sort);
+
+    rewind(output);
+    uint32_t previous = 0;
+    uint32_t value;
+    uint32_t count = 0;
+    while (fread(&value, sizeof(uint32_t), 1, output) == 1) {
+        assert_uint32(previous, <=, value);
+        previous = value;
+        count++;
+    }
+    assert_uint32(count, ==, EXTERNAL_SORT_TEST_SIZE);
+    fclose(output);
+
+    sort = getExternalSortInstance(sizeof(uint32_t), 1024, compareUInt32Values);    // fits in memory, no runs
+    assert_true(externalSortAdd(sort, (uint32_t[]) {9, 3, 7, 1, 5, 0, 8, 2, 6, 4}, 10));
+    assert_true(externalSortFinish(sort));
+    uint32_t head[3];
+    assert_uint32(externalSortRead(sort, head, ARRAY_SIZE(head)), ==, 3);
+    output = tmpfile();
+    assert_not_null(output);
+    assert_true(externalSortWrite(sort, output));   // only elements that were not read yet
+    externalSortDelete(sort);
+    rewind(output);
+    for (count = 0; fread(&value, sizeof(uint32_t), 1, output) == 1; count++) {
+        assert_uint32(value, ==, count + 3);
+    }
+    assert_uint32(count, ==, 7);
+    fclose(output);
+
+    assert_null(getExternalSortInstance(sizeof(uint32_t), 8, compareUInt32Values));    // less than three elements
+    assert_null(getExternalSortInstance(sizeof(uint32_t), 1024, NULL));
+    assert_uint32(externalSortRead(NULL, &value, 1), ==, 0);
+    return MUNIT_OK;
+}
+
+static MunitResult testExternalSortMergeFailure(const MunitParameter params[], void *data) {
+#if !defined(__unix__)
+    return MUNIT_SKIP;
+#else
+    struct rlimit limit;
+    assert_int(getrlimit(RLIMIT_FSIZE, &limit), ==, 0);
+    struct rlimit smallFiles = {.rlim_cur = 40 * 1024, .rlim_max = limit.rlim_max};   // spilled runs fit, merged run not
+    void (*previous)(int) = signal(SIGXFSZ, SIG_IGN);       // writes past limit fail instead of killing process
+
+    ExternalSort sort = getExternalSortInstance(sizeof(uint32_t), 16 * 1024, compareUInt32Values);
+    assert_not_null(sort);
+    assert_int(setrlimit(RLIMIT_FSIZE, &smallFiles), ==, 0);
+    bool isAdded = true;
+    for (uint32_t i = 0; i < EXTERNAL_SORT_TEST_SIZE && isAdded; i++) {
+        isAdded = externalSortAdd(sort, &i, 1);
+    }
+    bool isFinished = isAdded && externalSortFinish(sort);
+    setrlimit(RLIMIT_FSIZE, &limit);
+    signal(SIGXFSZ, previous);
+
+    assert_true(isAdded);
+    assert_false(isFinished);
+    assert_true(isExternalSortFailed(sort));
+    uint32_t value;
+    assert_uint32(externalSortRead(sort, &value, 1), ==, 0);
+    externalSortDelete(sort);
+    return MUNIT_OK;
+#endif
+}
+
+
+static MunitTest externalSortTests[] = {
+        {.name =  "Test externalSortRead() - should merge spilled runs in sorted chunks", .test = testExternalSortRead},
+        {.name =  "Test externalSortWrite() - should write sorted elements to file", .test = testExternalSortWrite},
+        {.name =  "Test externalSortFinish() - should fail when merged run can't be written", .test = testExternalSortMergeFailure},
+
+        END_OF_TESTS
+};
+
+static const MunitSuite externalSortTestSuite = {
+        .prefix = "ExternalSort: ",
+        .tests = externalSortTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "NumberBufferVector.h"
+
+CREATE_VECTOR_TYPE(int32_t);
+CREATE_VECTOR_TYPE(uint32_t);
+CREATE_VECTOR_TYPE(double);
+CREATE_VECTOR_TYPE(float, f32);
+CREATE_VECTOR_TYPE(uint8_t);
+CREATE_VECTOR_TYPE(int16_t);
+
+CREATE_NUMBER_VECTOR_METHODS(int32_t);
+CREATE_NUMBER_VECTOR_METHODS(uint32_t);
+CREATE_NUMBER_VECTOR_METHODS(double);
+CREATE_NUMBER_VECTOR_METHODS(float, f32);
+CREATE_NUMBER_VECTOR_METHODS(uint8_t);
+CREATE_NUMBER_VECTOR_METHODS(int8_t, i8);
+CREATE_NUMBER_VECTOR_METHODS(int16_t);
+
+
+static MunitResult testNumVecRemoveDupStable(const MunitParameter params[], void *data) {
+    int32_tVector *intVec = VECTOR(int32_t, 5, 3, 5, 1, 3, 7, 1, 5, -2);
+    uint32_t scratch[VECTOR_DEDUP_SCRATCH_LENGTH(9)];
+    assert_not_null(int32_tVecRemoveDupStable(intVec, scratch, ARRAY_SIZE(scratch)));  // first seen order: [5], [3], [1], [7], [-2]
+    assert_true(isint32_tVecEquals(intVec, VECTOR(int32_t, 5, 3, 1, 7, -2)));
+
+    uint32_tVector *u32Vec = NEW_VECTOR_1024(uint32_t);
+    for (uint32_t i = 0; i < 1000; i++) {
+        uint32_tVecAdd(u32Vec, (i * 7919u) % 250);   // each value from 0 to 249 repeats 4 times
+    }
+    uint32_t bigScratch[2000];
+    uint32_tVecRemoveDupStable(u32Vec, bigScratch, ARRAY_SIZE(bigScratch));
+    assert_uint32(uint32_tVecSize(u32Vec), ==, 250);
+    for (uint32_t i = 0; i < 250; i++) {
+        assert_uint32(uint32_tVecGet(u32Vec, i), ==, (i * 7919u) % 250);
+    }
+
+    doubleVector *dblVec = VECTOR(double, 1.5, 1.7, 1.5, 0.25, 1.7);
+    doubleVecRemoveDupStable(dblVec, scratch, ARRAY_SIZE(scratch));
+    assert_true(isdoubleVecEquals(dblVec, VECTOR(double, 1.5, 1.7, 0.25)));
+
+    doubleVector *fractionVec = NEW_VECTOR_1024(double);     // same integer part, every value in one chain before
+    for (uint32_t i = 0; i < 1000; i++) {
+        doubleVecAdd(fractionVec, (double) ((i * 7919u) % 500) / 1000.0);
+    }
+    doubleVecAdd(fractionVec, -0.0);
+    uint32_t fractionScratch[VECTOR_DEDUP_SCRATCH_LENGTH(1001)];
+    assert_not_null(doubleVecRemoveDupStable(fractionVec, fractionScratch, ARRAY_SIZE(fractionScratch)));
+    assert_uint32(doubleVecSize(fractionVec), ==, 500);     // -0.0 is duplicate of 0.0
+    for (uint32_t i = 0; i < 500; i++) {
+        assert_double_equal(doubleVecGet(fractionVec, i), (double) ((i * 7919u) % 500) / 1000.0, 6);
+    }
+
+    assert_null(int32_tVecRemoveDupStable(intVec, scratch, 4));    // scratch is too small
+    assert_null(int32_tVecRemoveDupStable(intVec, NULL, 0));
+    assert_null(int32_tVecRemoveDupStable(NULL, scratch, ARRAY_SIZE(scratch)));
+    return MUNIT_OK;
+}
+
+static MunitResult testNumVecCompaction(const MunitParameter params[], void *data) {
+    int32_tVector *intVec = NEW_VECTOR_1024(int32_t);
+    f32Vector *flVec = NEW_VECTOR_1024(f32, float);
+    uint32_tVector *u32Vec = NEW_VECTOR_1024(uint32_t);
+    for (int32_t i = 0; i < 1000; i++) {
+        int32_tVecAdd(intVec, (i * 37) % 201 - 100);    // -100 ... 100
+        f32VecAdd(flVec, (float) ((i * 37) % 201 - 100) / 4);
+        uint32_tVecAdd(u32Vec, (uint32_t) i * 4294967u);
+    }
+
+    int32_tVecRetainBetween(intVec, -10, 20);
+    f32VecRemoveWhere(flVec, VECTOR_GREATER_OR_EQUAL, -2.5f);
+    uint32_tVecRetainWhere(u32Vec, VECTOR_GREATER, 3000000000u);
+    assert_uint32(uint32_tVecSize(u32Vec), ==, 301);
+
+    uint32_t intIndex = 0;
+    uint32_t floatIndex = 0;
+    for (int32_t i = 0; i < 1000; i++) {   // order of kept elements should be preserved
+        int32_t value = (i * 37) % 201 - 100;
+        if (value >= -10 && value <= 20) {
+            assert_int32(int32_tVecGet(intVec, intIndex++), ==, value);
+        }
+        if ((float) value / 4 < -2.5f) {
+            assert_float(f32VecGet(flVec, floatIndex++), ==, (float) value / 4);
+        }
+    }
+    assert_uint32(int32_tVecSize(intVec), ==, intIndex);
+    assert_uint32(f32VecSize(flVec), ==, floatIndex);
+    assert_uint32(uint32_tVecGet(u32Vec, 0), ==, 699u * 4294967u);
+
+    doubleVector *dblVec = VECTOR(double, 1.5, -2.0, 3.25, 0, 7.0, 3.0);
+    doubleVecRemoveBetween(dblVec, 0, 3.0);  // [-2.0], [3.25], [7.0]
+    assert_true(isdoubleVecEquals(dblVec, VECTOR(double, -2.0, 3.25, 7.0)));
+    doubleVecRetainWhere(dblVec, VECTOR_NOT_EQUAL, 3.25);
+    assert_true(isdoubleVecEquals(dblVec, VECTOR(double, -2.0, 7.0)));
+
+    assert_null(int32_tVecRetainBetween(NULL, 0, 1));
+    return MUNIT_OK;
+}
+
+static MunitResult testNumVecReductions(const MunitParameter params[], void *data) {
+    int32_tVector *intVec = NEW_VECTOR_1024(int32_t);
+    uint32_tVector *u32Vec = NEW_VECTOR_1024(uint32_t);
+    f32Vector *flVec = NEW_VECTOR_1024(f32, float);
+    for (int32_t i = 0; i < 1003; i++) {
+        int32_tVecAdd(intVec, (i * 37) % 201 - 100);    // -100 ... 100
+        uint32_tVecAdd(u32Vec, UINT32_MAX - (uint32_t) i);
+        f32VecAdd(flVec, (float) ((i * 37) % 201 - 100) / 4);
+    }
+    int32_tVecPut(intVec, 999, 500);
+    int32_tVecPut(intVec, 700, -200);
+
+    int32_t min, max;
+    assert_true(int32_tVecMinMax(intVec, &min, &max));
+    assert_int32(min, ==, -200);
+    assert_int32(max, ==, 500);
+    assert_int32(int32_tVecMin(intVec), ==, -200);
+    assert_int32(int32_tVecArgMin(intVec), ==, 700);
+    assert_int32(int32_tVecArgMax(intVec), ==, 999);
+    assert_int32(f32VecArgMax(flVec), ==, 38);
+    assert_float(f32VecMax(flVec), ==, 25.0f);
+    assert_uint32(uint32_tVecMin(u32Vec), ==, UINT32_MAX - 1002);
+    assert_int32(uint32_tVecArgMax(u32Vec), ==, 0);
+
+    int64_t expectedSum = 0;
+    double expectedFloatSum = 0;
+    for (uint32_t i = 0; i < int32_tVecSize(intVec); i++) {
+        expectedSum += int32_tVecGet(intVec, i);
+        expectedFloatSum += f32VecGet(flVec, i);     // quarters are exact in double
+    }
+    assert_int64(int32_tVecSum(intVec), ==, expectedSum);
+    assert_uint64(uint32_tVecSum(u32Vec), ==, 1003ull * UINT32_MAX - (1002ull * 1003ull) / 2);   // no 32-bit overflow
+    assert_double(f32VecSum(flVec), ==, expectedFloatSum);
+
+    doubleVector *dblVec = VECTOR(double, 1e100, 1.0, -1e100, 2.0, 0.5);
+    assert_double(doubleVecSumCompensated(dblVec), ==, 3.5);
+    assert_double(doubleVecMax(dblVec), ==, 1e100);
+    assert_int32(doubleVecArgMin(dblVec), ==, 2);
+
+    int32_tVector *emptyVec = NEW_VECTOR_4(int32_t);
+    assert_false(int32_tVecMinMax(emptyVec, &min, &max));
+    assert_int32(int32_tVecArgMin(emptyVec), ==, -1);
+    assert_int64(int32_tVecSum(emptyVec), ==, 0);
+    assert_int32(int32_tVecArgMax(NULL), ==, -1);
+    return MUNIT_OK;
+}
+
+static MunitResult testNumVecDenseArithmetic(const MunitParameter params[], void *data) {
+    f32Vector *x = NEW_VECTOR_64(f32, float);
+    f32Vector *y = NEW_VECTOR_64(f32, float);
+    for (uint32_t i = 0; i < 37; i++) {     // odd size covers SIMD tail
+        f32VecAdd(x, (float) i);
+        f32VecAdd(y, 1.0f);
+    }
+
+    assert_ptr_equal(f32VecAxpy(y, 2.0f, x), y);
+    for (uint32_t i = 0; i < 37; i++) {
+        assert_float(f32VecGet(y, i), ==, 1.0f + 2.0f * (float) i);
+    }
+    f32VecElementMul(y, x);
+    assert_float(f32VecGet(y, 36), ==, 73.0f * 36.0f);
+    f32VecScale(y, 0.5f);
+    assert_float(f32VecGet(y, 10), ==, 105.0f);
+    assert_double(f32VecDot(x, x), ==, 36.0 * 37.0 * 73.0 / 6);    // sum of squares from 0 to 36
+
+    f32Vector *fractions = NEW_VECTOR_1024(f32, float);
+    double reference = 0;
+    for (uint32_t i = 0; i < 1003; i++) {   // float accumulator would drift far above this bound
+        f32VecAdd(fractions, 0.1f + (float) i / 7.0f);
+        reference += (double) f32VecGet(fractions, i) * f32VecGet(fractions, i);
+    }
+    assert_double_equal(f32VecDot(fractions, fractions) / reference, 1.0, 12);
+
+    doubleVector *first = VECTOR(double, 3.0, 0, 4.0);
+    doubleVector *second = VECTOR(double, 0, 2.0, 0);
+    assert_double(doubleVecNorm(first), ==, 5.0);
+    assert_double(doubleVecCosine(first, second), ==, 0);
+    assert_double_equal(doubleVecCosine(first, first), 1.0, 9);
+    doubleVecElementAdd(second, first);
+    assert_true(isdoubleVecEquals(second, VECTOR(double, 3.0, 2.0, 4.0)));
+
+    int32_tVector *intVec = VECTOR(int32_t, 1, -2, 3);
+    int32_tVecAxpy(intVec, 3, VECTOR(int32_t, 1, 1, 1));
+    assert_true(isint32_tVecEquals(intVec, VECTOR(int32_t, 4, 1, 6)));
+    assert_double(int32_tVecDot(intVec, intVec), ==, 53.0);
+
+    assert_null(doubleVecAxpy(first, 1.0, VECTOR(double, 1.0)));    // size mismatch
+    assert_null(doubleVecElementMul(first, NULL));
+    assert_double(doubleVecCosine(first, NEW_VECTOR_4(double)), ==, 0);
+    return MUNIT_OK;
+}
+
+static MunitResult testNumVecScanAndHistogram(const MunitParameter params[], void *data) {
+    uint32_tVector *offsets = NEW_VECTOR_1024(uint32_t);
+    int32_tVector *deltas = NEW_VECTOR_1024(int32_t);
+    for (uint32_t i = 0; i < 1001; i++) {
+        uint32_tVecAdd(offsets, i % 7);
+        int32_tVecAdd(deltas, (i % 2 == 0) ? (int32_t) i : -(int32_t) i);
+    }
+    uint32_tVecExclusiveScan(offsets);
+    int32_tVecInclusiveScan(deltas);
+    uint32_t expected = 0;
+    for (uint32_t i = 0; i < 1001; i++) {
+        assert_uint32(uint32_tVecGet(offsets, i), ==, expected);
+        expected += i % 7;
+        assert_int32(int32_tVecGet(deltas, i), ==, (i % 2 == 0) ? (int32_t) i / 2 : -((int32_t) i + 1) / 2);
+    }
+
+    int16_tVector *shortVec = VECTOR(int16_t, 3, -1, 4, 1, -5);
+    assert_true(isint16_tVecEquals(int16_tVecInclusiveScan(shortVec), VECTOR(int16_t, 3, 2, 6, 7, 2)));
+    doubleVector *dblVec = VECTOR(double, 0.5, 1.5, 2.0);
+    assert_true(isdoubleVecEquals(doubleVecExclusiveScan(dblVec), VECTOR(double, 0, 0.5, 2.0)));
+
+    uint8_tVector *bytes = NEW_VECTOR_1024(uint8_t);
+    for (uint32_t i = 0; i < 1000; i++) {
+        uint8_tVecAdd(bytes, (uint8_t) (i % 250));
+    }
+    uint32_t counts[256];
+    assert_true(uint8_tVecHistogram(bytes, counts, 256));
+    assert_uint32(counts[0], ==, 4);
+    assert_uint32(counts[249], ==, 4);
+    assert_uint32(counts[250], ==, 0);
+
+    i8Vector *signedBytes = NEW_VECTOR_OF(6, i8, int8_t, -3, 2, 2, 127, -128, 0);
+    assert_true(i8VecHistogram(signedBytes, counts, 3));    // negative and too large values are skipped
+    assert_uint32(counts[0], ==, 1);
+    assert_uint32(counts[1], ==, 0);
+    assert_uint32(counts[2], ==, 2);
+    assert_true(int16_tVecHistogram(VECTOR(int16_t, 1, 1, -1, 300), counts, 2));
+    assert_uint32(counts[1], ==, 2);
+
+    assert_null(int32_tVecInclusiveScan(NULL));
+    assert_false(uint8_tVecHistogram(bytes, NULL, 0));
+    return MUNIT_OK;
+}
+
+
+static MunitTest numberVectorTests[] = {
+        {.name =  "Test <type>VecRemoveDupStable() - should remove repeated values keeping first seen order", .test = testNumVecRemoveDupStable},
+        {.name =  "Test <type>VecRetain/Remove Where/Between() - should keep order of matching elements", .test = testNumVecCompaction},
+        {.name =  "Test <type>VecMin/Max/ArgMin/ArgMax/Sum() - should reduce vector to single value", .test = testNumVecReductions},
+        {.name =  "Test <type>VecAxpy/ElementAdd/ElementMul/Scale/Dot/Norm/Cosine() - should compute dense arithmetic", .test = testNumVecDenseArithmetic},
+        {.name =  "Test <type>VecInclusiveScan/ExclusiveScan/Histogram() - should compute prefix sums and value counts", .test = testNumVecScanAndHistogram},
+
+        END_OF_TESTS
+};
+
+static const MunitSuite numberVectorTestSuite = {
+        .prefix = "NumberBufferVector: ",
+        .tests = numberVectorTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -0,0 +1,426 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "NumberBufferVector.h"
+#include "Vector.h"
+#include "ThreadPool.h"
+
+#define PARALLEL_TEST_SIZE 200000
+
+CREATE_VECTOR_TYPE(int32_t, par32);
+CREATE_VECTOR_TYPE(double, parF64);
+CREATE_NUMBER_VECTOR_METHODS(int32_t, par32);
+
+static void *threadPoolSetup(const MunitParameter params[], void *userData) {
+    ThreadPool pool = getThreadPoolInstance(4);
+#ifdef VECTOR_ENABLE_THREADS
+    assert_not_null(pool);
+#endif
+    return pool;
+}
+
+static void threadPoolTearDown(void *pool) {
+    threadPoolDelete(pool);
+}
+
+static void incrementTask(void *context) {
+    __atomic_fetch_add((uint32_t *) context, 1, __ATOMIC_RELAXED);
+}
+
+static int comparePointerValues(const void *one, const void *two) {
+    intptr_t first = (intptr_t) *(VectorValueType const *) one;
+    intptr_t second = (intptr_t) *(VectorValueType const *) two;
+    return (first > second) - (first < second);
+}
+
+static MunitResult testThreadPoolTasks(const MunitParameter params[], void *pool) {
+#ifndef VECTOR_ENABLE_THREADS
+    return MUNIT_SKIP;
+#endif
+    assert_uint32(getThreadPoolSize(pool), ==, 4);
+    uint32_t counter = 0;
+    for (uint32_t i = 0; i < 1000; i++) {   // grows task queue
+        assert_true(threadPoolSubmit(pool, incrementTask, &counter));
+    }
+    threadPoolWait(pool);
+    assert_uint32(counter, ==, 1000);
+
+    ThreadPool callerOnly = getThreadPoolInstance(1);   // tasks run in threadPoolWait()
+    assert_true(threadPoolSubmit(callerOnly, incrementTask, &counter));
+    threadPoolWait(callerOnly);
+    threadPoolDelete(callerOnly);
+    assert_uint32(counter, ==, 1001);
+    assert_uint32(getThreadPoolSize(NULL), ==, 1);
+    return MUNIT_OK;
+}
+
+static MunitResult testParallelSort(const MunitParameter params[], void *pool) {
+    par32Vector intVec;
+    parF64Vector doubleVec;
+    newpar32BuffVector(&intVec, malloc(sizeof(int32_t) * PARALLEL_TEST_SIZE), PARALLEL_TEST_SIZE);
+    newparF64BuffVector(&doubleVec, malloc(sizeof(double) * PARALLEL_TEST_SIZE), PARALLEL_TEST_SIZE);
+    Vector vector = getVectorInstance(PARALLEL_TEST_SIZE);
+    for (uint32_t i = 0; i < PARALLEL_TEST_SIZE; i++) {
+        int32_t value = (i % 3 == 0) ? 42 : (int32_t) ((i * 2654435761u) >> 8) - (1 << 23);  // many duplicates
+        par32VecAdd(&intVec, value);
+        parF64VecAdd(&doubleVec, (double) value / 7);
+        vectorAdd(vector, (VectorValueType) (intptr_t) value);
+    }
+
+    par32VecParallelSort(&intVec, pool);
+    parF64VecParallelSort(&doubleVec, pool);
+    vectorParallelSort(vector, comparePointerValues, pool);
+    int64_t sum = 0;
+    for (uint32_t i = 0; i < PARALLEL_TEST_SIZE; i++) {
+        int32_t value = par32VecGet(&intVec, i);
+        sum += value;
+        if (i > 0) {
+            assert_int32(par32VecGet(&intVec, i - 1), <=, value);
+            assert_double(parF64VecGet(&doubleVec, i - 1), <=, parF64VecGet(&doubleVec, i));
+        }
+        assert_double(parF64VecGet(&doubleVec, i), ==, (double) value / 7);
+        assert_int64((intptr_t) vectorGet(vector, i), ==, value);
+    }
+    int64_t expectedSum = 0;
+    for (uint32_t i = 0; i < PARALLEL_TEST_SIZE; i++) {     // same elements after sort
+        expectedSum += (i % 3 == 0) ? 42 : (int32_t) ((i * 2654435761u) >> 8) - (1 << 23);
+    }
+    assert_int64(sum, ==, expectedSum);
+
+    par32Vector *smallVec = VECTOR_OF(par32, int32_t, 3, 1, 2);     // sequential sort
+    assert_ptr_equal(par32VecParallelSort(smallVec, pool), smallVec);
+    assert_true(ispar32VecEquals(smallVec, VECTOR_OF(par32, int32_t, 1, 2, 3)));
+    assert_null(par32VecParallelSort(NULL, pool));
+
+    free(intVec.items);
+    free(doubleVec.items);
+    vectorDelete(vector);
+    return MUNIT_OK;
+}
+
+static int compareInt64Values(const void *one, const void *two) {
+    int64_t first = *(const int64_t *) one;
+    int64_t second = *(const int64_t *) two;
+    return (first > second) - (first < second);
+}
+
+static int compareUInt32ValuesDirect(const void *one, const void *two) {
+    return uint32_tComparator(*(const uint32_t *) one, *(const uint32_t *) two);
+}
+
+static MunitResult testParallelRadixSort(const MunitParameter params[], void *pool) {
+    int64_t *wide = malloc(sizeof(int64_t) * PARALLEL_TEST_SIZE);
+    int64_t *wideExpected = malloc(sizeof(int64_t) * PARALLEL_TEST_SIZE);
+    uint32_t *narrow = malloc(sizeof(uint32_t) * PARALLEL_TEST_SIZE);
+    uint32_t *narrowExpected = malloc(sizeof(uint32_t) * PARALLEL_TEST_SIZE);
+    for (uint32_t i = 0; i < PARALLEL_TEST_SIZE; i++) {
+        wide[i] = (int64_t) ((uint64_t) i * 0x9E3779B97F4A7C15u);   // negative and positive 64-bit keys
+        narrow[i] = (i * 2654435761u) % 1000;       // upper digits are same, their passes are skipped
+    }
+    memcpy(wideExpected, wide, sizeof(int64_t) * PARALLEL_TEST_SIZE);
+    memcpy(narrowExpected, narrow, sizeof(uint32_t) * PARALLEL_TEST_SIZE);
+    qsort(wideExpected, PARALLEL_TEST_SIZE, sizeof(int64_t), compareInt64Values);
+    qsort(narrowExpected, PARALLEL_TEST_SIZE, sizeof(uint32_t), compareUInt32ValuesDirect);
+
+    assert_true(parallelRadixSort(wide, PARALLEL_TEST_SIZE, VECTOR_ELEMENT_I64, pool));
+    assert_true(parallelRadixSort(narrow, PARALLEL_TEST_SIZE, VECTOR_ELEMENT_U32, NULL));   // caller thread only
+    assert_memory_equal(sizeof(int64_t) * PARALLEL_TEST_SIZE, wide, wideExpected);
+    assert_memory_equal(sizeof(uint32_t) * PARALLEL_TEST_SIZE, narrow, narrowExpected);
+
+    int32_t small[] = {5, -3, 7, -3, 0};
+    assert_true(parallelRadixSort(small, ARRAY_SIZE(small), VECTOR_ELEMENT_I32, pool));
+    assert_memory_equal(sizeof(small), small, ((int32_t[]) {-3, -3, 0, 5, 7}));
+    assert_false(parallelRadixSort(small, ARRAY_SIZE(small), VECTOR_ELEMENT_F32, pool));
+
+    free(wide);
+    free(wideExpected);
+    free(narrow);
+    free(narrowExpected);
+    return MUNIT_OK;
+}
+
+typedef struct ParallelForContext {
+    ThreadPool pool;
+    uint32_t grain;
+    uint64_t sum;
+    uint32_t calls;
+} ParallelForContext;
+
+static void sumRange(uint32_t begin, uint32_t end, void *context) {
+    ParallelForContext *ctx = context;
+    assert_uint32(end - begin, <=, ctx->grain);
+    uint64_t sum = 0;
+    for (uint32_t i = begin; i < end; i++) {
+        sum += i;
+    }
+    __atomic_fetch_add(&ctx->sum, sum, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&ctx->calls, 1, __ATOMIC_RELAXED);
+}
+
+static void nestedRange(uint32_t begin, uint32_t end, void *context) {
+    ParallelForContext *ctx = context;
+    for (uint32_t i = begin; i < end; i++) {    // inner loops run on worker deques
+        ParallelForContext inner = {.pool = ctx->pool, .grain = 16};
+        parallelFor(ctx->pool, 0, 1000, inner.grain, sumRange, &inner);
+        __atomic_fetch_add(&ctx->sum, inner.sum, __ATOMIC_RELAXED);
+    }
+}
+
+static MunitResult testParallelFor(const MunitParameter params[], void *pool) {
+    uint32_t grains[] = {1, 7, 1000, 1u << 20};
+    for (uint32_t i = 0; i < ARRAY_SIZE(grains); i++) {
+        ParallelForContext context = {.pool = pool, .grain = grains[i]};
+        parallelFor(pool, 10, 100010, grains[i], sumRange, &context);
+        assert_uint64(context.sum, ==, (uint64_t) 100009 * 100010 / 2 - 45);
+        assert_uint32(context.calls, >=, 100000 / grains[i]);
+    }
+
+    ParallelForContext nested = {.pool = pool};
+    parallelFor(pool, 0, 64, 1, nestedRange, &nested);
+    assert_uint64(nested.sum, ==, (uint64_t) 64 * 999 * 1000 / 2);
+
+    ParallelForContext sequential = {.grain = 40};
+    parallelFor(NULL, 0, 100, 40, sumRange, &sequential);   // no pool, subranges run on caller thread
+    assert_uint32(sequential.calls, ==, 3);
+    assert_uint64(sequential.sum, ==, 4950);
+    parallelFor(pool, 5, 5, 1, sumRange, &sequential);      // empty range
+    assert_uint32(sequential.calls, ==, 3);
+    return MUNIT_OK;
+}
+
+typedef struct ScoredRecord {
+    uint32_t id;
+    double weight;
+} ScoredRecord;
+
+static void doubleItem(void *item, void *context) {
+    *(int32_t *) item *= 2;
+}
+
+static void scoreRecord(const void *item, void *result, void *context) {
+    const ScoredRecord *record = *(VectorValueType const *) item;
+    *(double *) result = record->weight * *(double *) context;
+}
+
+static void addScore(void *partial, const void *item, void *context) {
+    const ScoredRecord *record = *(VectorValueType const *) item;
+    *(double *) partial += record->weight;
+}
+
+static void addInt32(void *partial, const void *item, void *context) {
+    *(int64_t *) partial += *(const int32_t *) item;
+}
+
+static void addDouble(void *partial, const void *other, void *context) {
+    *(double *) partial += *(const double *) other;
+}
+
+static void addInt64(void *partial, const void *other, void *context) {
+    *(int64_t *) partial += *(const int64_t *) other;
+}
+
+static MunitResult testParallelMapReduce(const MunitParameter params[], void *pool) {
+    par32Vector intVec;
+    newpar32BuffVector(&intVec, malloc(sizeof(int32_t) * PARALLEL_TEST_SIZE), PARALLEL_TEST_SIZE);
+    ScoredRecord *records = malloc(sizeof(ScoredRecord) * PARALLEL_TEST_SIZE);
+    Vector vector = getVectorInstance(PARALLEL_TEST_SIZE);
+    for (uint32_t i = 0; i < PARALLEL_TEST_SIZE; i++) {
+        par32VecAdd(&intVec, (int32_t) i - 1000);
+        records[i] = (ScoredRecord) {.id = i, .weight = 1.0 / (i + 1)};
+        vectorAdd(vector, &records[i]);
+    }
+
+    assert_ptr_equal(par32VecParallelForEach(&intVec, doubleItem, NULL, pool), &intVec);
+    ParallelReducer intSum = {.resultSize = sizeof(int64_t), .accumulate = addInt32, .combine = addInt64};
+    int64_t sum = 0;
+    assert_true(par32VecParallelReduce(&intVec, &intSum, &sum, pool));
+    assert_int64(sum, ==, (int64_t) PARALLEL_TEST_SIZE * (PARALLEL_TEST_SIZE - 1) - (int64_t) 2000 * PARALLEL_TEST_SIZE);
+    sum = 0;
+    assert_true(par32VecParallelReduce(&intVec, &intSum, &sum, NULL));  // same result on caller thread
+    assert_int64(sum, ==, (int64_t) PARALLEL_TEST_SIZE * (PARALLEL_TEST_SIZE - 1) - (int64_t) 2000 * PARALLEL_TEST_SIZE);
+
+    double factor = 2;
+    double *scores = malloc(sizeof(double) * PARALLEL_TEST_SIZE);
+    vectorParallelMap(vector, scores, sizeof(double), scoreRecord, &factor, pool);
+    for (uint32_t i = 0; i < PARALLEL_TEST_SIZE; i++) {
+        assert_double(scores[i], ==, 2.0 / (i + 1));
+    }
+
+    ParallelReducer scoreSum = {.resultSize = sizeof(double), .accumulate = addScore, .combine = addDouble, .isDeterministic = true};
+    double poolTotal = 0;
+    double callerTotal = 0;
+    ThreadPool smallPool = getThreadPoolInstance(2);
+    assert_true(vectorParallelReduce(vector, &scoreSum, &poolTotal, pool));
+    assert_true(vectorParallelReduce(vector, &scoreSum, &callerTotal, smallPool));
+    assert_memory_equal(sizeof(double), &poolTotal, &callerTotal);  // same chunks, same rounding
+    assert_double_equal(poolTotal, 12.7832908, 6);    // harmonic number H(200000)
+    threadPoolDelete(smallPool);
+
+    parF64Vector emptyVec;
+    double emptyItems[1];
+    double total = 5;
+    newparF64BuffVector(&emptyVec, emptyItems, 1);
+    assert_true(parF64VecParallelReduce(&emptyVec, &scoreSum, &total, pool));    // identity is kept
+    assert_double(total, ==, 5);
+    assert_false(parF64VecParallelReduce(NULL, &scoreSum, &total, pool));
+    assert_false(par32VecParallelMap(&intVec, NULL, sizeof(double), scoreRecord, NULL, pool));
+
+    free(intVec.items);
+    free(records);
+    free(scores);
+    vectorDelete(vector);
+    return MUNIT_OK;
+}
+
+typedef struct SearchContext {
+    uint32_t calls;
+    intptr_t value;
+} SearchContext;
+
+static bool isPointerValue(const void *item, void *context) {
+    SearchContext *search = context;
+    __atomic_fetch_add(&search->calls, 1, __ATOMIC_RELAXED);
+    return (intptr_t) *(VectorValueType const *) item == search->value;
+}
+
+static MunitResult testParallelIndexOf(const MunitParameter params[], void *pool) {
+    par32Vector intVec;
+    newpar32BuffVector(&intVec, malloc(sizeof(int32_t) * PARALLEL_TEST_SIZE), PARALLEL_TEST_SIZE);
+    Vector vector = getVectorInstance(PARALLEL_TEST_SIZE);
+    for (uint32_t i = 0; i < PARALLEL_TEST_SIZE; i++) {
+        par32VecAdd(&intVec, (int32_t) (i % 150000));   // values after 150000 repeat, first index wins
+        vectorAdd(vector, (VectorValueType) (intptr_t) (i % 150000));
+    }
+
+    assert_int32(par32VecParallelIndexOf(&intVec, 0, pool), ==, 0);
+    assert_int32(par32VecParallelIndexOf(&intVec, 42, pool), ==, 42);
+    assert_int32(par32VecParallelIndexOf(&intVec, 149999, pool), ==, 149999);
+    assert_int32(par32VecParallelIndexOf(&intVec, -1, pool), ==, -1);
+    for (uint32_t i = 0; i < 50; i++) {
+        int32_t value = (int32_t) ((i * 2654435761u) % 150000);
+        assert_int32(par32VecParallelIndexOf(&intVec, value, pool), ==, par32VecIndexOf(&intVec, value));
+    }
+
+    SearchContext early = {.value = 7};
+    assert_int32(vectorParallelIndexOf(vector, isPointerValue, &early, pool), ==, 7);
+    assert_uint32(early.calls, <, PARALLEL_TEST_SIZE);  // ranges after match are cancelled
+    SearchContext late = {.value = 100000};
+    assert_int32(vectorParallelIndexOf(vector, isPointerValue, &late, NULL), ==, 100000);
+    assert_uint32(late.calls, ==, 100001);
+    SearchContext missing = {.value = -5};
+    assert_int32(vectorParallelIndexOf(vector, isPointerValue, &missing, pool), ==, -1);
+    assert_uint32(missing.calls, ==, PARALLEL_TEST_SIZE);
+    assert_int32(par32VecParallelIndexOf(NULL, 1, pool), ==, -1);
+
+    free(intVec.items);
+    vectorDelete(vector);
+    return MUNIT_OK;
+}
+
+static void fillSetInput(par32Vector *vector, uint32_t size, uint32_t seed, uint32_t range, bool isSorted) {
+    par32VecClear(vector);
+    for (uint32_t i = 0; i < size; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        par32VecAdd(vector, (int32_t) (seed >> 8) % (int32_t) range - (int32_t) range / 2);
+    }
+    if (isSorted) par32VecSort(vector);
+}
+
+static MunitResult testParallelSetOperations(const MunitParameter params[], void *pool) {
+    par32Vector expected, actual, source, sourceCopy;
+    newpar32BuffVector(&expected, malloc(sizeof(int32_t) * PARALLEL_TEST_SIZE * 2), PARALLEL_TEST_SIZE * 2);
+    newpar32BuffVector(&actual, malloc(sizeof(int32_t) * PARALLEL_TEST_SIZE * 2), PARALLEL_TEST_SIZE * 2);
+    newpar32BuffVector(&source, malloc(sizeof(int32_t) * PARALLEL_TEST_SIZE), PARALLEL_TEST_SIZE);
+    newpar32BuffVector(&sourceCopy, malloc(sizeof(int32_t) * PARALLEL_TEST_SIZE), PARALLEL_TEST_SIZE);
+    uint32_t ranges[] = {50, 150000, 1u << 30};     // heavy duplicates, some and almost none
+    for (uint32_t r = 0; r < ARRAY_SIZE(ranges); r++) {
+        for (uint32_t operation = 0; operation < 3; operation++) {
+            bool isSorted = (r + operation) % 2 == 0;
+            fillSetInput(&expected, PARALLEL_TEST_SIZE, 7 + r, ranges[r], isSorted);
+            fillSetInput(&actual, PARALLEL_TEST_SIZE, 7 + r, ranges[r], isSorted);
+            fillSetInput(&source, PARALLEL_TEST_SIZE * 3 / 4, 99 + operation, ranges[r], isSorted);
+            par32VecClear(&sourceCopy);
+            par32VecAddAll(&sourceCopy, &source);
+
+            if (operation == 0) {
+                par32VecUnion(&expected, &source);
+                assert_ptr_equal(par32VecParallelUnion(&actual, &sourceCopy, pool), &actual);
+                assert_true(ispar32VecEquals(&source, &sourceCopy));    // source is not changed
+            } else if (operation == 1) {
+                par32VecIntersect(&expected, &source);
+                assert_ptr_equal(par32VecParallelIntersect(&actual, &sourceCopy, pool), &actual);
+            } else {
+                par32VecSubtract(&expected, &source);
+                assert_ptr_equal(par32VecParallelSubtract(&actual, &sourceCopy, pool), &actual);
+            }
+            assert_uint32(actual.size, ==, expected.size);
+            assert_true(ispar32VecEquals(&actual, &expected));
+        }
+    }
+
+    par32Vector full, expectedFull;     // union doesn't fit, so items are dropped same way as sequential one
+    newpar32BuffVector(&full, malloc(sizeof(int32_t) * PARALLEL_TEST_SIZE), PARALLEL_TEST_SIZE);
+    newpar32BuffVector(&expectedFull, expected.items, PARALLEL_TEST_SIZE);
+    fillSetInput(&full, PARALLEL_TEST_SIZE / 2 + 10, 5, 1u << 30, false);
+    fillSetInput(&expectedFull, PARALLEL_TEST_SIZE / 2 + 10, 5, 1u << 30, false);
+    fillSetInput(&source, PARALLEL_TEST_SIZE / 2, 6, 1u << 30, false);
+    par32VecUnion(&expectedFull, &source);
+    par32VecParallelUnion(&full, &source, pool);
+    assert_uint32(full.size, <, PARALLEL_TEST_SIZE);
+    assert_true(ispar32VecEquals(&full, &expectedFull));
+    assert_null(par32VecParallelIntersect(NULL, &source, pool));
+
+    uint32_t *counts = malloc(sizeof(uint32_t) * PARALLEL_TEST_SIZE);
+    uint32_t *expectedCounts = malloc(sizeof(uint32_t) * PARALLEL_TEST_SIZE);
+    for (uint32_t i = 0; i < PARALLEL_TEST_SIZE; i++) {
+        counts[i] = expectedCounts[i] = (i * 2654435761u) >> 20;
+    }
+    parallelPrefixSum32(counts, PARALLEL_TEST_SIZE, true, pool);
+    vectorKernelScan32(expectedCounts, PARALLEL_TEST_SIZE, true, 0);
+    assert_memory_equal(sizeof(uint32_t) * PARALLEL_TEST_SIZE, counts, expectedCounts);
+
+    par32Vector deltas;
+    newpar32BuffVector(&deltas, malloc(sizeof(int32_t) * PARALLEL_TEST_SIZE), PARALLEL_TEST_SIZE);
+    for (uint32_t i = 0; i < PARALLEL_TEST_SIZE; i++) {
+        par32VecAdd(&deltas, (i % 2 == 0) ? (int32_t) i : -(int32_t) i);
+    }
+    assert_ptr_equal(par32VecParallelInclusiveScan(&deltas, pool), &deltas);
+    for (uint32_t i = 0; i < PARALLEL_TEST_SIZE; i++) {
+        assert_int32(deltas.items[i], ==, (i % 2 == 0) ? (int32_t) i / 2 : -((int32_t) i + 1) / 2);
+    }
+    par32VecParallelExclusiveScan(&deltas, pool);
+    assert_int32(deltas.items[0], ==, 0);
+    assert_int32(deltas.items[2], ==, -1);
+    assert_null(par32VecParallelInclusiveScan(NULL, pool));
+
+    free(expected.items);
+    free(actual.items);
+    free(source.items);
+    free(sourceCopy.items);
+    free(full.items);
+    free(counts);
+    free(expectedCounts);
+    free(deltas.items);
+    return MUNIT_OK;
+}
+
+
+static MunitTest parallelTests[] = {
+        {.name =  "Test threadPoolSubmit() - should run every task", .test = testThreadPoolTasks, .setup = threadPoolSetup, .tear_down = threadPoolTearDown},
+        {.name =  "Test parallelFor() - should process every subrange once", .test = testParallelFor, .setup = threadPoolSetup, .tear_down = threadPoolTearDown},
+        {.name =  "Test <type>VecParallelSort() - should sort with thread pool", .test = testParallelSort, .setup = threadPoolSetup, .tear_down = threadPoolTearDown},
+        {.name =  "Test parallelRadixSort() - should sort 32 and 64-bit integers", .test = testParallelRadixSort, .setup = threadPoolSetup, .tear_down = threadPoolTearDown},
+        {.name =  "Test <type>VecParallelReduce() - should map and reduce in parallel", .test = testParallelMapReduce, .setup = threadPoolSetup, .tear_down = threadPoolTearDown},
+        {.name =  "Test <type>VecParallelIndexOf() - should find first match", .test = testParallelIndexOf, .setup = threadPoolSetup, .tear_down = threadPoolTearDown},
+        {.name =  "Test <type>VecParallelUnion() - should match sequential set operations", .test = testParallelSetOperations, .setup = threadPoolSetup, .tear_down = threadPoolTearDown},
+
+        END_OF_TESTS
+};
+
+static const MunitSuite parallelTestSuite = {
+        .prefix = "Parallel: ",
+        .tests = parallelTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
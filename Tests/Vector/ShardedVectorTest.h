@@ -0,0 +1,147 @@
+#pragma once
+
+#include "BaseTestTemplate.h"
+#include "ShardedVector.h"
+#include "ThreadPool.h"
+
+#define SHARDED_TEST_ITEMS 200000
+
+typedef struct ShardedFill {
+    ShardedVector vector;
+    ThreadPool pool;
+} ShardedFill;
+
+static void fillShards(uint32_t begin, uint32_t end, void *context) {
+    ShardedFill *fill = context;
+    uint32_t shard = getThreadPoolWorkerIndex(fill->pool);
+    for (uint32_t i = begin; i < end; i++) {
+        assert_true(shardedVectorAdd(fill->vector, shard, (VectorValueType) (uintptr_t) (i + 1)));
+    }
+}
+
+static void sumShard(uint32_t shard, VectorValueType *items, uint32_t size, void *context) {
+    uint64_t *sums = context;
+    for (uint32_t i = 0; i < size; i++) {
+        sums[shard] += (uintptr_t) items[i];
+    }
+}
+
+static MunitResult testShardedVectorCollect(const MunitParameter params[], void *data) {
+    ShardedVector vector = getShardedVectorInstance(3, 0);
+    assert_not_null(vector);
+    assert_uint32(getShardCount(vector), ==, 3);
+    for (uintptr_t i = 1; i <= 100; i++) {      // shard 1 grows several times, shard 2 stays empty
+        assert_true(shardedVectorAdd(vector, 1, (VectorValueType) i));
+    }
+    assert_true(shardedVectorAdd(vector, 0, (VectorValueType) 500));
+    assert_false(shardedVectorAdd(vector, 3, (VectorValueType) 1));
+    assert_uint32(getShardSize(vector, 1), ==, 100);
+    assert_uint32(getShardSize(vector, 2), ==, 0);
+    assert_uint32(getShardedVectorSize(vector), ==, 101);
+    assert_ptr_equal(shardedVectorGet(vector, 1, 99), (VectorValueType) 100);
+    assert_null(shardedVectorGet(vector, 1, 100));
+
+    Vector dest = getVectorInstance(2);
+    vectorAdd(dest, (VectorValueType) 1000);
+    assert_true(shardedVectorCollect(vector, dest, NULL));
+    assert_uint32(getVectorSize(dest), ==, 102);
+    assert_ptr_equal(vectorGet(dest, 0), (VectorValueType) 1000);
+    assert_ptr_equal(vectorGet(dest, 1), (VectorValueType) 500);    // shard order, then item order
+    for (uint32_t i = 0; i < 100; i++) {
+        assert_ptr_equal(vectorGet(dest, i + 2), (VectorValueType) (uintptr_t) (i + 1));
+    }
+    assert_uint32(getShardedVectorSize(vector), ==, 0);
+
+    Vector pending = getVectorInstance(16);
+    VectorValueType *window = vectorReserveRange(pending, 10);  // capacity fits shards, but not with this window
+    assert_not_null(window);
+    for (uintptr_t i = 0; i < 10; i++) {
+        window[i] = (VectorValueType) (i + 1);
+        assert_true(shardedVectorAdd(vector, 2, (VectorValueType) (i + 100)));
+    }
+    assert_false(shardedVectorCollect(vector, pending, NULL));
+    assert_uint32(getShardSize(vector, 2), ==, 10);     // shard is kept
+    assert_uint32(vectorCommitRanges(pending), ==, 10);
+    assert_true(shardedVectorCollect(vector, pending, NULL));
+    assert_uint32(getVectorSize(pending), ==, 20);
+    assert_ptr_equal(vectorGet(pending, 9), (VectorValueType) 10);
+    assert_ptr_equal(vectorGet(pending, 10), (VectorValueType) 100);
+    vectorDelete(pending);
+
+    pending = getVectorInstance(16);
+    window = vectorReserveRange(pending, 10);   // growth is needed, but it would move written window
+    for (uintptr_t i = 0; i < 10; i++) {
+        window[i] = (VectorValueType) (i + 1);
+    }
+    for (uintptr_t i = 0; i < 20; i++) {
+        assert_true(shardedVectorAdd(vector, 1, (VectorValueType) (i + 200)));
+    }
+    assert_false(shardedVectorCollect(vector, pending, NULL));
+    assert_uint32(getShardSize(vector, 1), ==, 20);
+    assert_uint32(vectorCommitRanges(pending), ==, 10);
+    for (uint32_t i = 0; i < 10; i++) {
+        assert_ptr_equal(vectorGet(pending, i), (VectorValueType) (uintptr_t) (i + 1));     // window is kept
+    }
+    assert_true(shardedVectorCollect(vector, pending, NULL));
+    assert_uint32(getVectorSize(pending), ==, 30);
+    assert_ptr_equal(vectorGet(pending, 29), (VectorValueType) 219);
+    vectorDelete(pending);
+
+    assert_true(shardedVectorAdd(vector, 2, (VectorValueType) 7));
+    shardedVectorClear(vector);
+    assert_uint32(getShardedVectorSize(vector), ==, 0);
+    assert_false(shardedVectorCollect(vector, NULL, NULL));
+    vectorDelete(dest);
+    shardedVectorDelete(vector);
+    return MUNIT_OK;
+}
+
+static MunitResult testShardedVectorThreads(const MunitParameter params[], void *data) {
+    ThreadPool pool = getThreadPoolInstance(4);
+    ShardedFill fill = {.vector = getShardedVectorInstance(getThreadPoolSize(pool), 1024), .pool = pool};
+    assert_not_null(fill.vector);
+    parallelFor(pool, 0, SHARDED_TEST_ITEMS, 1000, fillShards, &fill);
+    assert_uint32(getShardedVectorSize(fill.vector), ==, SHARDED_TEST_ITEMS);
+
+    uint64_t *sums = calloc(getShardCount(fill.vector), sizeof(uint64_t));  // shard-local pass, nothing is merged
+    shardedVectorForEach(fill.vector, sumShard, sums, pool);
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < getShardCount(fill.vector); i++) {
+        total += sums[i];
+    }
+    assert_uint64(total, ==, (uint64_t) SHARDED_TEST_ITEMS * (SHARDED_TEST_ITEMS + 1) / 2);
+
+    Vector dest = getVectorInstance(16);
+    assert_true(shardedVectorCollect(fill.vector, dest, pool));
+    assert_uint32(getVectorSize(dest), ==, SHARDED_TEST_ITEMS);
+    uint8_t *isSeen = calloc(SHARDED_TEST_ITEMS + 1, 1);
+    for (uint32_t i = 0; i < SHARDED_TEST_ITEMS; i++) {
+        uintptr_t value = (uintptr_t) vectorGet(dest, i);
+        assert_uint32(value, >=, 1);
+        assert_uint32(value, <=, SHARDED_TEST_ITEMS);
+        assert_uint32(isSeen[value], ==, 0);    // every item once
+        isSeen[value] = 1;
+    }
+
+    free(isSeen);
+    free(sums);
+    vectorDelete(dest);
+    shardedVectorDelete(fill.vector);
+    threadPoolDelete(pool);
+    return MUNIT_OK;
+}
+
+static MunitTest shardedVectorTests[] = {
+        {.name =  "Test shardedVectorCollect() - should append shards in order", .test = testShardedVectorCollect},
+        {.name =  "Test shardedVectorForEach() - should visit shards filled by pool threads", .test = testShardedVectorThreads},
+
+        END_OF_TESTS
+};
+
+static const MunitSuite shardedVectorTestSuite = {
+        .prefix = "ShardedVector: ",
+        .tests = shardedVectorTests,
+        .suites = NULL,
+        .iterations = 1,
+        .options = MUNIT_SUITE_OPTION_NONE
+};
@@ -140,6 +140,75 @@ static MunitResult testVectorSingleton(const MunitParameter params[], void *vect
     return MUNIT_OK;
 }
 
+#define RESERVE_TEST_WRITERS 4
+#define RESERVE_TEST_CHUNKS 64
+
+typedef struct ReserveWriter {
+    Vector vector;
+    uint32_t index;
+} ReserveWriter;
+
+static void fillReservedChunks(void *context) {    // every writer decodes chunks of known length
+    ReserveWriter *writer = context;
+    for (uint32_t chunk = writer->index; chunk < RESERVE_TEST_CHUNKS; chunk += RESERVE_TEST_WRITERS) {
+        VectorValueType *window = vectorReserveRange(writer->vector, chunk + 1);
+        assert_not_null(window);
+        for (uint32_t i = 0; i <= chunk; i++) {
+            window[i] = (VectorValueType) (intptr_t) (chunk * 1000 + i);
+        }
+    }
+}
+
+static MunitResult testVectorReserveRange(const MunitParameter params[], void *vector) {
+    vectorAdd(vector, (VectorValueType) 7);
+    uint32_t total = RESERVE_TEST_CHUNKS * (RESERVE_TEST_CHUNKS + 1) / 2;
+    assert_true(vectorEnsureCapacity(vector, total + 1));
+    ThreadPool pool = getThreadPoolInstance(RESERVE_TEST_WRITERS);
+    ReserveWriter writers[RESERVE_TEST_WRITERS];
+    for (uint32_t i = 0; i < RESERVE_TEST_WRITERS; i++) {
+        writers[i] = (ReserveWriter) {.vector = vector, .index = i};
+        if (!threadPoolSubmit(pool, fillReservedChunks, &writers[i])) {
+            fillReservedChunks(&writers[i]);    // threads are disabled
+        }
+    }
+    threadPoolWait(pool);
+    threadPoolDelete(pool);
+    assert_int(getVectorSize(vector), ==, 1);   // nothing is visible before commit
+    assert_null(vectorReserveRange(vector, UINT32_MAX));    // window larger than capacity
+    assert_int(vectorCommitRanges(vector), ==, total + 1);
+
+    uint32_t found = 0;
+    assert_int((intptr_t) vectorGet(vector, 0), ==, 7);
+    for (uint32_t i = 1; i <= total; i++) {     // windows are contiguous, chunk items stay in order
+        intptr_t value = (intptr_t) vectorGet(vector, i);
+        if (value % 1000 == 0) {
+            found++;
+            for (intptr_t j = 1; j <= value / 1000; j++) {
+                assert_int((intptr_t) vectorGet(vector, i + j), ==, value + j);
+            }
+        }
+    }
+    assert_int(found, ==, RESERVE_TEST_CHUNKS);
+
+    VectorValueType *window = vectorReserveRange(vector, 2);
+    assert_not_null(window);
+    window[0] = (VectorValueType) 5;
+    window[1] = (VectorValueType) 6;
+    assert_true(vectorEnsureCapacity(vector, total + 3));   // fits, nothing moves
+    assert_false(vectorEnsureCapacity(vector, 4 * total));  // growth would free array under window
+    assert_int(vectorCommitRanges(vector), ==, total + 3);
+    assert_int((intptr_t) vectorGet(vector, total + 2), ==, 6);
+    assert_true(vectorEnsureCapacity(vector, 4 * total));
+
+    assert_not_null(vectorReserveRange(vector, 0));
+    vectorClear(vector);    // drops uncommitted windows
+    assert_not_null(vectorReserveRange(vector, 3));
+    vectorClear(vector);
+    assert_int(vectorCommitRanges(vector), ==, 0);
+    assert_null(vectorReserveRange(NULL, 1));
+    return MUNIT_OK;
+}
+
 static void vectorTearDown(void *vector) {
     vectorDelete(vector);
     vector = NULL;
@@ -195,6 +264,12 @@ static MunitTest vectorTests[] = {
                 .setup = vectorSetup,
                 .tear_down = vectorTearDown
         },
+        {
+                .name =  "Test vectorReserveRange() - should fill disjoint windows from many threads",
+                .test = testVectorReserveRange,
+                .setup = vectorSetup,
+                .tear_down = vectorTearDown
+        },
         END_OF_TESTS
 };
 
@@ -1,10 +1,15 @@
 #include "Vector/VectorTest.h"
 #include "Vector/BufferVectorTest.h"
+#include "Vector/NumberBufferVectorTest.h"
+#include "Vector/ExternalSortTest.h"
+#include "Vector/ParallelTest.h"
+#include "Vector/ConcurrentVectorTest.h"
+#include "Vector/ShardedVectorTest.h"
 
 
 int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
     MunitTest emptyTests[] = {END_OF_TESTS};
-    MunitSuite testSuitArray[] = {vectorTestSuite, bufferVectorTestSuite};
+    MunitSuite testSuitArray[] = {vectorTestSuite, bufferVectorTestSuite, numberVectorTestSuite, externalSortTestSuite, parallelTestSuite, concurrentVectorTestSuite, shardedVectorTestSuite, {NULL}};
 
     MunitSuite baseSuite = {
             .prefix = "",
@@ -0,0 +1,413 @@
+#include "ThreadPool.h"
+#include <stdlib.h>
+#include <unistd.h>
+
+uint32_t getOnlineCpuCount(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint32_t) count : 1;
+}
+
+static void runSequential(uint32_t begin, uint32_t end, uint32_t grain, ParallelForFunction function, void *context) {
+    for (uint32_t from = begin; from < end; from += (end - from > grain) ? grain : end - from) {
+        function(from, (end - from > grain) ? from + grain : end, context);
+    }
+}
+
+#ifdef VECTOR_ENABLE_THREADS
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+#define TASK_QUEUE_INITIAL_CAPACITY 64
+#define WORK_DEQUE_CAPACITY 4096        // split depth is logarithmic, full deque runs range in place
+#define STEAL_ATTEMPTS 64               // rounds over other deques before worker goes to sleep
+
+typedef struct PoolTask {
+    ThreadPoolTask function;
+    void *context;
+} PoolTask;
+
+typedef struct RangeJob RangeJob;
+
+typedef struct RangeTask {
+    RangeJob *job;
+    uint32_t begin;
+    uint32_t end;
+} RangeTask;
+
+struct RangeJob {
+    ParallelForFunction function;
+    void *context;
+    uint32_t grain;
+    atomic_uint remaining;      // elements not processed yet
+};
+
+typedef struct WorkSlot {       // range is kept by value, so memory is bounded by deque depth and nothing is allocated
+    _Atomic(RangeJob *) job;
+    atomic_ullong range;        // begin in high half, end in low half
+} WorkSlot;
+
+typedef struct WorkDeque {      // Chase-Lev deque, owner pushes and takes at bottom, thieves steal from top
+    atomic_llong top;
+    atomic_llong bottom;
+    WorkSlot slots[WORK_DEQUE_CAPACITY];
+} WorkDeque;
+
+typedef struct Worker {
+    ThreadPool pool;
+    uint32_t index;
+} Worker;
+
+struct ThreadPool {
+    pthread_t *threads;
+    Worker *workers;            // last one stands for external thread that owns last deque
+    uint32_t workerCount;
+    WorkDeque *deques;          // one per worker, last one belongs to external caller
+    pthread_mutex_t externalLock;   // only one external thread owns last deque at a time
+    pthread_mutex_t lock;
+    pthread_cond_t workAvailable;
+    pthread_cond_t workDone;
+    PoolTask *tasks;            // ring buffer of submitted tasks
+    uint32_t taskCapacity;
+    uint32_t taskHead;
+    atomic_uint taskCount;
+    uint32_t pendingCount;      // queued and running submitted tasks
+    atomic_uint queuedRanges;   // range tasks in deques, tells sleeping workers that there is work
+    atomic_uint idleCount;
+    bool isStopped;
+};
+
+static _Thread_local Worker *currentWorker;
+
+static void *runWorker(void *argument);
+static bool takeTask(ThreadPool pool, PoolTask *task);
+static void completeTask(ThreadPool pool);
+static bool pushRange(ThreadPool pool, WorkDeque *deque, RangeTask task);
+static bool takeRange(ThreadPool pool, WorkDeque *deque, RangeTask *task);
+static bool stealRange(ThreadPool pool, uint32_t thief, RangeTask *task);
+static void runRange(ThreadPool pool, WorkDeque *deque, RangeTask task);
+
+
+ThreadPool getThreadPoolInstance(uint32_t threadCount) {
+    if (threadCount == 0) threadCount = getOnlineCpuCount();
+
+    ThreadPool pool = calloc(1, sizeof(struct ThreadPool));
+    if (pool == NULL) return NULL;
+    pool->tasks = malloc(sizeof(PoolTask) * TASK_QUEUE_INITIAL_CAPACITY);
+    pool->taskCapacity = TASK_QUEUE_INITIAL_CAPACITY;
+    pool->threads = malloc(sizeof(pthread_t) * threadCount);
+    pool->workers = malloc(sizeof(Worker) * (threadCount + 1));
+    pool->deques = calloc(threadCount, sizeof(WorkDeque));
+    if (pool->tasks == NULL || pool->threads == NULL || pool->workers == NULL || pool->deques == NULL) {
+        free(pool->tasks);
+        free(pool->threads);
+        free(pool->workers);
+        free(pool->deques);
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->externalLock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->workAvailable, NULL);
+    pthread_cond_init(&pool->workDone, NULL);
+
+    for (uint32_t i = 0; i + 1 < threadCount; i++) {
+        pool->workers[i] = (Worker) {.pool = pool, .index = i};
+        if (pthread_create(&pool->threads[i], NULL, runWorker, &pool->workers[i]) != 0) break;  // works with fewer threads
+        pool->workerCount++;
+    }
+    pool->workers[pool->workerCount] = (Worker) {.pool = pool, .index = pool->workerCount};
+    return pool;
+}
+
+bool threadPoolSubmit(ThreadPool pool, ThreadPoolTask task, void *context) {
+    if (pool == NULL || task == NULL) return false;
+    pthread_mutex_lock(&pool->lock);
+    uint32_t taskCount = atomic_load(&pool->taskCount);
+    if (taskCount == pool->taskCapacity) {
+        PoolTask *tasks = malloc(sizeof(PoolTask) * pool->taskCapacity * 2);
+        if (tasks == NULL) {
+            pthread_mutex_unlock(&pool->lock);
+            return false;
+        }
+        for (uint32_t i = 0; i < taskCount; i++) {  // unwrap ring in new buffer
+            tasks[i] = pool->tasks[(pool->taskHead + i) % pool->taskCapacity];
+        }
+        free(pool->tasks);
+        pool->tasks = tasks;
+        pool->taskHead = 0;
+        pool->taskCapacity *= 2;
+    }
+    pool->tasks[(pool->taskHead + taskCount) % pool->taskCapacity] = (PoolTask) {task, context};
+    atomic_store(&pool->taskCount, taskCount + 1);
+    pool->pendingCount++;
+    pthread_cond_signal(&pool->workAvailable);
+    pthread_mutex_unlock(&pool->lock);
+    return true;
+}
+
+void threadPoolWait(ThreadPool pool) {
+    if (pool == NULL) return;
+    PoolTask task;
+    while (takeTask(pool, &task)) {     // caller runs queued tasks instead of sleeping
+        task.function(task.context);
+        completeTask(pool);
+    }
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pendingCount > 0) {
+        pthread_cond_wait(&pool->workDone, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void parallelFor(ThreadPool pool, uint32_t begin, uint32_t end, uint32_t grain, ParallelForFunction function, void *context) {
+    if (function == NULL || begin >= end) return;
+    if (grain == 0) grain = 1;
+    if (pool == NULL || pool->workerCount == 0 || end - begin <= grain) {   // nothing to share
+        runSequential(begin, end, grain, function, context);
+        return;
+    }
+
+    bool isWorker = currentWorker != NULL && currentWorker->pool == pool;  // nested call uses thread's own deque
+    Worker *previousWorker = currentWorker;
+    if (!isWorker) {
+        pthread_mutex_lock(&pool->externalLock);
+        currentWorker = &pool->workers[pool->workerCount];
+    }
+    uint32_t self = currentWorker->index;
+    WorkDeque *deque = &pool->deques[self];
+
+    RangeJob job = {.function = function, .context = context, .grain = grain};
+    atomic_init(&job.remaining, end - begin);
+    runRange(pool, deque, (RangeTask) {.job = &job, .begin = begin, .end = end});
+    while (atomic_load_explicit(&job.remaining, memory_order_acquire) > 0) {    // help until every range is done
+        RangeTask task;
+        if (takeRange(pool, deque, &task) || stealRange(pool, self, &task)) {
+            runRange(pool, deque, task);
+        } else {
+            sched_yield();
+        }
+    }
+
+    if (!isWorker) {
+        currentWorker = previousWorker;
+        pthread_mutex_unlock(&pool->externalLock);
+    }
+}
+
+uint32_t getThreadPoolSize(ThreadPool pool) {
+    return pool != NULL ? pool->workerCount + 1 : 1;
+}
+
+uint32_t getThreadPoolWorkerIndex(ThreadPool pool) {
+    if (pool == NULL) return 0;
+    return (currentWorker != NULL && currentWorker->pool == pool) ? currentWorker->index : pool->workerCount;
+}
+
+void threadPoolDelete(ThreadPool pool) {
+    if (pool == NULL) return;
+    threadPoolWait(pool);
+    pthread_mutex_lock(&pool->lock);
+    pool->isStopped = true;
+    pthread_cond_broadcast(&pool->workAvailable);
+    pthread_mutex_unlock(&pool->lock);
+    for (uint32_t i = 0; i < pool->workerCount; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_mutex_destroy(&pool->externalLock);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->workAvailable);
+    pthread_cond_destroy(&pool->workDone);
+    free(pool->threads);
+    free(pool->workers);
+    free(pool->deques);
+    free(pool->tasks);
+    free(pool);
+}
+
+static bool hasWork(ThreadPool pool) {
+    return atomic_load(&pool->queuedRanges) > 0 || atomic_load(&pool->taskCount) > 0;
+}
+
+static void *runWorker(void *argument) {
+    Worker *worker = argument;
+    ThreadPool pool = worker->pool;
+    WorkDeque *deque = &pool->deques[worker->index];
+    currentWorker = worker;
+    while (true) {
+        RangeTask range;
+        bool isTaken = takeRange(pool, deque, &range);
+        for (uint32_t attempt = 0; !isTaken && attempt < STEAL_ATTEMPTS && atomic_load(&pool->queuedRanges) > 0; attempt++) {
+            isTaken = stealRange(pool, worker->index, &range);
+        }
+        if (isTaken) {
+            runRange(pool, deque, range);
+            continue;
+        }
+
+        PoolTask task;
+        if (takeTask(pool, &task)) {
+            task.function(task.context);
+            completeTask(pool);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        atomic_fetch_add(&pool->idleCount, 1);  // pushers read idle count after publishing work, so wakeup is not lost
+        while (!pool->isStopped && !hasWork(pool)) {
+            pthread_cond_wait(&pool->workAvailable, &pool->lock);
+        }
+        atomic_fetch_sub(&pool->idleCount, 1);
+        bool isStopped = pool->isStopped && !hasWork(pool);
+        pthread_mutex_unlock(&pool->lock);
+        if (isStopped) break;
+    }
+    return NULL;
+}
+
+static bool takeTask(ThreadPool pool, PoolTask *task) {
+    if (atomic_load(&pool->taskCount) == 0) return false;
+    pthread_mutex_lock(&pool->lock);
+    uint32_t taskCount = atomic_load(&pool->taskCount);
+    bool isTaken = taskCount > 0;
+    if (isTaken) {
+        *task = pool->tasks[pool->taskHead];
+        pool->taskHead = (pool->taskHead + 1) % pool->taskCapacity;
+        atomic_store(&pool->taskCount, taskCount - 1);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return isTaken;
+}
+
+static void completeTask(ThreadPool pool) {
+    pthread_mutex_lock(&pool->lock);
+    if (--pool->pendingCount == 0) {
+        pthread_cond_broadcast(&pool->workDone);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static inline void writeSlot(WorkSlot *slot, RangeTask task) {
+    atomic_store_explicit(&slot->job, task.job, memory_order_relaxed);
+    atomic_store_explicit(&slot->range, (uint64_t) task.begin << 32 | task.end, memory_order_relaxed);
+}
+
+static inline RangeTask readSlot(WorkSlot *slot) {  // thief may read slot that is rewritten, its CAS on top fails then
+    uint64_t range = atomic_load_explicit(&slot->range, memory_order_relaxed);
+    RangeJob *job = atomic_load_explicit(&slot->job, memory_order_relaxed);
+    return (RangeTask) {.job = job, .begin = (uint32_t) (range >> 32), .end = (uint32_t) range};
+}
+
+static bool pushRange(ThreadPool pool, WorkDeque *deque, RangeTask task) {
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    long long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    if (bottom - top >= WORK_DEQUE_CAPACITY) return false;
+    writeSlot(&deque->slots[bottom % WORK_DEQUE_CAPACITY], task);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);     // publishes task, visible to sanitizers unlike fence
+
+    atomic_fetch_add(&pool->queuedRanges, 1);
+    if (atomic_load(&pool->idleCount) > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_signal(&pool->workAvailable);
+        pthread_mutex_unlock(&pool->lock);
+    }
+    return true;
+}
+
+static bool takeRange(ThreadPool pool, WorkDeque *deque, RangeTask *task) {
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    bool isTaken = false;
+    if (top <= bottom) {
+        *task = readSlot(&deque->slots[bottom % WORK_DEQUE_CAPACITY]);
+        isTaken = true;
+        if (top == bottom) {    // last task, race with thieves
+            isTaken = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+            atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        }
+    } else {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+    if (isTaken) atomic_fetch_sub(&pool->queuedRanges, 1);
+    return isTaken;
+}
+
+static bool stealFrom(ThreadPool pool, WorkDeque *deque, RangeTask *task) {
+    long long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (top >= bottom) return false;
+    *task = readSlot(&deque->slots[top % WORK_DEQUE_CAPACITY]);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)) {
+        return false;   // lost race, caller tries again
+    }
+    atomic_fetch_sub(&pool->queuedRanges, 1);
+    return true;
+}
+
+static bool stealRange(ThreadPool pool, uint32_t thief, RangeTask *task) {
+    uint32_t dequeCount = pool->workerCount + 1;
+    for (uint32_t i = 1; i < dequeCount; i++) {
+        if (stealFrom(pool, &pool->deques[(thief + i) % dequeCount], task)) return true;
+    }
+    return false;
+}
+
+static void runRange(ThreadPool pool, WorkDeque *deque, RangeTask task) {
+    RangeJob *job = task.job;
+    uint32_t begin = task.begin;
+    uint32_t end = task.end;
+    while (end - begin > job->grain) {  // lazy binary splitting, thieves take bigger halves first
+        uint32_t middle = begin + (end - begin) / 2;
+        if (!pushRange(pool, deque, (RangeTask) {.job = job, .begin = middle, .end = end})) break;   // deque is full, rest of range runs here
+        end = middle;
+    }
+    job->function(begin, end, job->context);
+    atomic_fetch_sub_explicit(&job->remaining, end - begin, memory_order_release);
+}
+
+#else
+
+// Threads are disabled at build time: no pool is created and parallel algorithms run on caller thread
+
+ThreadPool getThreadPoolInstance(uint32_t threadCount) {
+    (void) threadCount;
+    return NULL;
+}
+
+bool threadPoolSubmit(ThreadPool pool, ThreadPoolTask task, void *context) {
+    (void) pool;
+    (void) task;
+    (void) context;
+    return false;
+}
+
+void threadPoolWait(ThreadPool pool) {
+    (void) pool;
+}
+
+void parallelFor(ThreadPool pool, uint32_t begin, uint32_t end, uint32_t grain, ParallelForFunction function, void *context) {
+    (void) pool;
+    if (function != NULL) {
+        runSequential(begin, end, grain > 0 ? grain : 1, function, context);
+    }
+}
+
+uint32_t getThreadPoolSize(ThreadPool pool) {
+    (void) pool;
+    return 1;
+}
+
+uint32_t getThreadPoolWorkerIndex(ThreadPool pool) {
+    (void) pool;
+    return 0;
+}
+
+void threadPoolDelete(ThreadPool pool) {
+    (void) pool;
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "Vector.h"
+#include <stdatomic.h>
 
 #define MIN(x, y) (((x)<(y))?(x):(y))
 
@@ -10,6 +11,7 @@ struct Vector {
     uint32_t initialCapacity;
     uint32_t capacity;
     uint32_t size;
+    atomic_uint reservedCount;      // items in claimed windows after size, not committed yet
 };
 
 Vector getVectorInstance(uint32_t capacity) {
@@ -20,6 +22,7 @@ Vector getVectorInstance(uint32_t capacity) {
     vector->size = 0;
     vector->capacity = capacity;
     vector->initialCapacity = capacity;
+    atomic_init(&vector->reservedCount, 0);
     vector->itemArray = calloc(vector->capacity, sizeof(VectorValueType));
 
     if (vector->itemArray == NULL) {
@@ -77,6 +80,30 @@ VectorValueType vectorRemoveAt(Vector vector, uint32_t index) {
     return (VectorValueType) NULL;
 }
 
+bool vectorEnsureCapacity(Vector vector, uint32_t capacity) {
+    if (vector == NULL) return false;
+    while (vector->capacity < capacity) {
+        if (!doubleVectorCapacity(vector)) return false;
+    }
+    return true;
+}
+
+VectorValueType *vectorReserveRange(Vector vector, uint32_t count) {
+    if (vector == NULL) return NULL;
+    uint32_t reserved = atomic_load_explicit(&vector->reservedCount, memory_order_relaxed);
+    do {    // size and capacity don't change while writers are active
+        if (count > vector->capacity - vector->size - reserved) return NULL;
+    } while (!atomic_compare_exchange_weak_explicit(&vector->reservedCount, &reserved, reserved + count,
+                                                    memory_order_relaxed, memory_order_relaxed));
+    return vector->itemArray + vector->size + reserved;
+}
+
+uint32_t vectorCommitRanges(Vector vector) {
+    if (vector == NULL) return 0;
+    vector->size += atomic_exchange_explicit(&vector->reservedCount, 0, memory_order_relaxed);
+    return vector->size;
+}
+
 bool isVectorEmpty(Vector vector) {
     return vector != NULL && vector->size == 0;
 }
@@ -89,9 +116,36 @@ uint32_t getVectorSize(Vector vector) {
     return vector != NULL ? vector->size : 0;
 }
 
+void vectorParallelSort(Vector vector, ParallelComparator comparator, ThreadPool pool) {
+    if (vector != NULL) {
+        parallelSort(vector->itemArray, vector->size, sizeof(VectorValueType), comparator, pool);
+    }
+}
+
+void vectorParallelForEach(Vector vector, ParallelItemFunction function, void *context, ThreadPool pool) {
+    if (vector != NULL) {
+        parallelForEach(vector->itemArray, vector->size, sizeof(VectorValueType), function, context, pool);
+    }
+}
+
+void vectorParallelMap(Vector vector, void *results, uint32_t resultSize, ParallelMapFunction function, void *context, ThreadPool pool) {
+    if (vector != NULL) {
+        parallelMap(vector->itemArray, results, vector->size, sizeof(VectorValueType), resultSize, function, context, pool);
+    }
+}
+
+bool vectorParallelReduce(Vector vector, const ParallelReducer *reducer, void *result, ThreadPool pool) {
+    return vector != NULL && parallelReduce(vector->itemArray, vector->size, sizeof(VectorValueType), reducer, result, pool);
+}
+
+int32_t vectorParallelIndexOf(Vector vector, ParallelPredicate predicate, void *context, ThreadPool pool) {
+    return vector != NULL ? parallelFindFirst(vector->itemArray, vector->size, sizeof(VectorValueType), predicate, context, pool) : -1;
+}
+
 void vectorClear(Vector vector) {
     if (vector != NULL) {
         vector->size = 0;
+        atomic_store_explicit(&vector->reservedCount, 0, memory_order_relaxed);
         while (vector->capacity > vector->initialCapacity) {
             if (!halfVectorCapacity(vector)) break;
         }
@@ -112,6 +166,7 @@ void initSingletonVector(Vector *vector, uint32_t capacity) {
 }
 
 static bool doubleVectorCapacity(Vector vector) {
+    if (atomic_load_explicit(&vector->reservedCount, memory_order_relaxed) != 0) return false;  // windows point in old array
     uint32_t newCapacity = vector->capacity * 2;
     if (newCapacity < vector->capacity) return false;   // overflow (capacity would be too big)
 
@@ -0,0 +1,1113 @@
+#include "VectorKernels.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// AVX2 kernels are compiled for x86 regardless of build flags and selected at runtime
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define VECTOR_KERNELS_AVX2
+#include <immintrin.h>
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#define FMA_FUNCTION __attribute__((target("avx2,fma")))
+#endif
+
+#define COMPARE_UNORDERED 2     // result of comparing NaN with anything
+
+#ifdef VECTOR_KERNELS_AVX2
+// Packed 4-bit lane indexes moving lanes selected by 8-bit mask to the front of register
+static const uint32_t COMPRESS_TABLE_8[256] = {
+        0x00000000, 0x00000000, 0x00000001, 0x00000010, 0x00000002, 0x00000020, 0x00000021, 0x00000210,
+        0x00000003, 0x00000030, 0x00000031, 0x00000310, 0x00000032, 0x00000320, 0x00000321, 0x00003210,
+        0x00000004, 0x00000040, 0x00000041, 0x00000410, 0x00000042, 0x00000420, 0x00000421, 0x00004210,
+        0x00000043, 0x00000430, 0x00000431, 0x00004310, 0x00000432, 0x00004320, 0x00004321, 0x00043210,
+        0x00000005, 0x00000050, 0x00000051, 0x00000510, 0x00000052, 0x00000520, 0x00000521, 0x00005210,
+        0x00000053, 0x00000530, 0x00000531, 0x00005310, 0x00000532, 0x00005320, 0x00005321, 0x00053210,
+        0x00000054, 0x00000540, 0x00000541, 0x00005410, 0x00000542, 0x00005420, 0x00005421, 0x00054210,
+        0x00000543, 0x00005430, 0x00005431, 0x00054310, 0x00005432, 0x00054320, 0x00054321, 0x00543210,
+        0x00000006, 0x00000060, 0x00000061, 0x00000610, 0x00000062, 0x00000620, 0x00000621, 0x00006210,
+        0x00000063, 0x00000630, 0x00000631, 0x00006310, 0x00000632, 0x00006320, 0x00006321, 0x00063210,
+        0x00000064, 0x00000640, 0x00000641, 0x00006410, 0x00000642, 0x00006420, 0x00006421, 0x00064210,
+        0x00000643, 0x00006430, 0x00006431, 0x00064310, 0x00006432, 0x00064320, 0x00064321, 0x00643210,
+        0x00000065, 0x00000650, 0x00000651, 0x00006510, 0x00000652, 0x00006520, 0x00006521, 0x00065210,
+        0x00000653, 0x00006530, 0x00006531, 0x00065310, 0x00006532, 0x00065320, 0x00065321, 0x00653210,
+        0x00000654, 0x00006540, 0x00006541, 0x00065410, 0x00006542, 0x00065420, 0x00065421, 0x00654210,
+        0x00006543, 0x00065430, 0x00065431, 0x00654310, 0x00065432, 0x00654320, 0x00654321, 0x06543210,
+        0x00000007, 0x00000070, 0x00000071, 0x00000710, 0x00000072, 0x00000720, 0x00000721, 0x00007210,
+        0x00000073, 0x00000730, 0x00000731, 0x00007310, 0x00000732, 0x00007320, 0x00007321, 0x00073210,
+        0x00000074, 0x00000740, 0x00000741, 0x00007410, 0x00000742, 0x00007420, 0x00007421, 0x00074210,
+        0x00000743, 0x00007430, 0x00007431, 0x00074310, 0x00007432, 0x00074320, 0x00074321, 0x00743210,
+        0x00000075, 0x00000750, 0x00000751, 0x00007510, 0x00000752, 0x00007520, 0x00007521, 0x00075210,
+        0x00000753, 0x00007530, 0x00007531, 0x00075310, 0x00007532, 0x00075320, 0x00075321, 0x00753210,
+        0x00000754, 0x00007540, 0x00007541, 0x00075410, 0x00007542, 0x00075420, 0x00075421, 0x00754210,
+        0x00007543, 0x00075430, 0x00075431, 0x00754310, 0x00075432, 0x00754320, 0x00754321, 0x07543210,
+        0x00000076, 0x00000760, 0x00000761, 0x00007610, 0x00000762, 0x00007620, 0x00007621, 0x00076210,
+        0x00000763, 0x00007630, 0x00007631, 0x00076310, 0x00007632, 0x00076320, 0x00076321, 0x00763210,
+        0x00000764, 0x00007640, 0x00007641, 0x00076410, 0x00007642, 0x00076420, 0x00076421, 0x00764210,
+        0x00007643, 0x00076430, 0x00076431, 0x00764310, 0x00076432, 0x00764320, 0x00764321, 0x07643210,
+        0x00000765, 0x00007650, 0x00007651, 0x00076510, 0x00007652, 0x00076520, 0x00076521, 0x00765210,
+        0x00007653, 0x00076530, 0x00076531, 0x00765310, 0x00076532, 0x00765320, 0x00765321, 0x07653210,
+        0x00007654, 0x00076540, 0x00076541, 0x00765410, 0x00076542, 0x00765420, 0x00765421, 0x07654210,
+        0x00076543, 0x00765430, 0x00765431, 0x07654310, 0x00765432, 0x07654320, 0x07654321, 0x76543210
+};
+#endif
+
+static inline uint32_t bitCount(uint32_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t) __builtin_popcount(value);
+#else
+    uint32_t count = 0;
+    for (; value != 0; value &= value - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+static inline bool isLess32(uint32_t one, uint32_t two, bool isSigned) {
+    return isSigned ? (int32_t) one < (int32_t) two : one < two;
+}
+
+static inline bool isAvx2Supported(void) {
+#ifdef VECTOR_KERNELS_AVX2
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+static inline bool isFmaSupported(void) {
+#ifdef VECTOR_KERNELS_AVX2
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    return false;
+#endif
+}
+
+static inline int compare32(uint32_t one, uint32_t two, VectorElementKind kind) {
+    if (kind == VECTOR_ELEMENT_F32) {
+        float oneValue, twoValue;
+        memcpy(&oneValue, &one, sizeof(float));
+        memcpy(&twoValue, &two, sizeof(float));
+        return oneValue < twoValue ? -1 : oneValue > twoValue ? 1 : oneValue == twoValue ? 0 : COMPARE_UNORDERED;
+    }
+    bool isSigned = kind == VECTOR_ELEMENT_I32;
+    return isLess32(one, two, isSigned) ? -1 : isLess32(two, one, isSigned) ? 1 : 0;
+}
+
+static inline bool isMatching32(uint32_t value, VectorElementKind kind, VectorCompareOperator compareOperator, uint32_t first, uint32_t second) {
+    int result = compare32(value, first, kind);
+    switch (compareOperator) {
+        case VECTOR_LESS:
+            return result == -1;
+        case VECTOR_LESS_OR_EQUAL:
+            return result == -1 || result == 0;
+        case VECTOR_GREATER:
+            return result == 1;
+        case VECTOR_GREATER_OR_EQUAL:
+            return result == 1 || result == 0;
+        case VECTOR_EQUAL:
+            return result == 0;
+        case VECTOR_NOT_EQUAL:
+            return result != 0;
+        case VECTOR_BETWEEN:
+            if (result != 0 && result != 1) return false;
+            result = compare32(value, second, kind);
+            return result == -1 || result == 0;
+    }
+    return false;
+}
+
+static uint32_t compact32(uint32_t *items, uint32_t from, uint32_t to, uint32_t size, VectorElementKind kind,
+                          VectorCompareOperator compareOperator, uint32_t first, uint32_t second, bool isRetained) {
+    for (uint32_t i = from; i < size; i++) {    // branchless, every element is written
+        uint32_t value = items[i];
+        items[to] = value;
+        to += isMatching32(value, kind, compareOperator, first, second) == isRetained;
+    }
+    return to;
+}
+
+#ifdef VECTOR_KERNELS_AVX2
+AVX2_FUNCTION static inline __m256i compareFloat8(__m256 values, __m256 first, VectorCompareOperator compareOperator) {
+    switch (compareOperator) {
+        case VECTOR_LESS:
+            return _mm256_castps_si256(_mm256_cmp_ps(values, first, _CMP_LT_OQ));
+        case VECTOR_LESS_OR_EQUAL:
+            return _mm256_castps_si256(_mm256_cmp_ps(values, first, _CMP_LE_OQ));
+        case VECTOR_GREATER:
+            return _mm256_castps_si256(_mm256_cmp_ps(values, first, _CMP_GT_OQ));
+        case VECTOR_GREATER_OR_EQUAL:
+            return _mm256_castps_si256(_mm256_cmp_ps(values, first, _CMP_GE_OQ));
+        case VECTOR_EQUAL:
+            return _mm256_castps_si256(_mm256_cmp_ps(values, first, _CMP_EQ_OQ));
+        default:
+            return _mm256_castps_si256(_mm256_cmp_ps(values, first, _CMP_NEQ_UQ));
+    }
+}
+
+AVX2_FUNCTION static inline __m256i compareInt8(__m256i values, __m256i first, VectorCompareOperator compareOperator) {
+    __m256i allOnes = _mm256_set1_epi32(-1);
+    switch (compareOperator) {
+        case VECTOR_LESS:
+            return _mm256_cmpgt_epi32(first, values);
+        case VECTOR_LESS_OR_EQUAL:
+            return _mm256_xor_si256(_mm256_cmpgt_epi32(values, first), allOnes);
+        case VECTOR_GREATER:
+            return _mm256_cmpgt_epi32(values, first);
+        case VECTOR_GREATER_OR_EQUAL:
+            return _mm256_xor_si256(_mm256_cmpgt_epi32(first, values), allOnes);
+        case VECTOR_EQUAL:
+            return _mm256_cmpeq_epi32(values, first);
+        default:
+            return _mm256_xor_si256(_mm256_cmpeq_epi32(values, first), allOnes);
+    }
+}
+
+AVX2_FUNCTION static uint32_t compact32Avx2(uint32_t *items, uint32_t size, VectorElementKind kind,
+                                            VectorCompareOperator compareOperator, uint32_t first, uint32_t second, bool isRetained) {
+    bool isFloat = kind == VECTOR_ELEMENT_F32;
+    __m256i signBit = _mm256_set1_epi32(kind == VECTOR_ELEMENT_U32 ? INT32_MIN : 0);  // unsigned values compared as signed
+    __m256i firstValues = _mm256_xor_si256(_mm256_set1_epi32((int32_t) first), signBit);
+    __m256i secondValues = _mm256_xor_si256(_mm256_set1_epi32((int32_t) second), signBit);
+    __m256i shifts = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+    uint32_t keepMask = isRetained ? 0 : 0xFF;
+
+    uint32_t i = 0;
+    uint32_t j = 0;
+    for (; i + 8 <= size; i += 8) {
+        __m256i values = _mm256_loadu_si256((const __m256i *) (items + i));
+        __m256i match;
+        if (isFloat && compareOperator == VECTOR_BETWEEN) {
+            match = _mm256_and_si256(compareFloat8(_mm256_castsi256_ps(values), _mm256_castsi256_ps(firstValues), VECTOR_GREATER_OR_EQUAL),
+                                     compareFloat8(_mm256_castsi256_ps(values), _mm256_castsi256_ps(secondValues), VECTOR_LESS_OR_EQUAL));
+        } else if (isFloat) {
+            match = compareFloat8(_mm256_castsi256_ps(values), _mm256_castsi256_ps(firstValues), compareOperator);
+        } else if (compareOperator == VECTOR_BETWEEN) {
+            __m256i signedValues = _mm256_xor_si256(values, signBit);
+            match = _mm256_and_si256(compareInt8(signedValues, firstValues, VECTOR_GREATER_OR_EQUAL),
+                                     compareInt8(signedValues, secondValues, VECTOR_LESS_OR_EQUAL));
+        } else {
+            match = compareInt8(_mm256_xor_si256(values, signBit), firstValues, compareOperator);
+        }
+
+        uint32_t mask = ((uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(match))) ^ keepMask;
+        __m256i permutation = _mm256_srlv_epi32(_mm256_set1_epi32((int32_t) COMPRESS_TABLE_8[mask]), shifts);
+        _mm256_storeu_si256((__m256i *) (items + j), _mm256_permutevar8x32_epi32(values, permutation));  // never passes unread items
+        j += bitCount(mask);
+    }
+    return compact32(items, i, j, size, kind, compareOperator, first, second, isRetained);
+}
+#endif
+
+
+uint32_t vectorKernelIntersectCount32(const void *first, uint32_t firstSize, const void *second, uint32_t secondSize, bool isSigned) {
+    const uint32_t *one = first;
+    const uint32_t *two = second;
+    uint32_t count = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+#if defined(__SSE2__)
+    // Compare 4x4 blocks all-against-all, values are unique so each lane of 'one' can match only once
+    while (i + 4 <= firstSize && j + 4 <= secondSize) {
+        __m128i blockOne = _mm_loadu_si128((const __m128i *) (one + i));
+        __m128i blockTwo = _mm_loadu_si128((const __m128i *) (two + j));
+        __m128i match = _mm_cmpeq_epi32(blockOne, blockTwo);
+        match = _mm_or_si128(match, _mm_cmpeq_epi32(blockOne, _mm_shuffle_epi32(blockTwo, _MM_SHUFFLE(0, 3, 2, 1))));
+        match = _mm_or_si128(match, _mm_cmpeq_epi32(blockOne, _mm_shuffle_epi32(blockTwo, _MM_SHUFFLE(1, 0, 3, 2))));
+        match = _mm_or_si128(match, _mm_cmpeq_epi32(blockOne, _mm_shuffle_epi32(blockTwo, _MM_SHUFFLE(2, 1, 0, 3))));
+        count += bitCount((uint32_t) _mm_movemask_ps(_mm_castsi128_ps(match)));
+
+        uint32_t lastOne = one[i + 3];
+        uint32_t lastTwo = two[j + 3];
+        if (!isLess32(lastTwo, lastOne, isSigned)) i += 4;
+        if (!isLess32(lastOne, lastTwo, isSigned)) j += 4;
+    }
+#endif
+
+    while (i < firstSize && j < secondSize) {
+        if (isLess32(one[i], two[j], isSigned)) {
+            i++;
+        } else if (isLess32(two[j], one[i], isSigned)) {
+            j++;
+        } else {
+            count++;
+            i++;
+            j++;
+        }
+    }
+    return count;
+}
+
+uint32_t vectorKernelCompact32(void *items, uint32_t size, VectorElementKind kind, VectorCompareOperator compareOperator,
+                               const void *first, const void *second, bool isRetained) {
+    uint32_t firstBits;
+    uint32_t secondBits = 0;
+    memcpy(&firstBits, first, sizeof(uint32_t));
+    if (second != NULL) {
+        memcpy(&secondBits, second, sizeof(uint32_t));
+    }
+#ifdef VECTOR_KERNELS_AVX2
+    if (isAvx2Supported()) {
+        return compact32Avx2(items, size, kind, compareOperator, firstBits, secondBits, isRetained);
+    }
+#endif
+    return compact32(items, 0, 0, size, kind, compareOperator, firstBits, secondBits, isRetained);
+}
+
+static void minMax32(const void *items, uint32_t from, uint32_t size, VectorElementKind kind, void *min, void *max) {
+    if (kind == VECTOR_ELEMENT_F32) {
+        const float *values = items;
+        float minValue = *(float *) min;
+        float maxValue = *(float *) max;
+        for (uint32_t i = from; i < size; i++) {
+            minValue = values[i] < minValue ? values[i] : minValue;
+            maxValue = values[i] > maxValue ? values[i] : maxValue;
+        }
+        *(float *) min = minValue;
+        *(float *) max = maxValue;
+    } else if (kind == VECTOR_ELEMENT_F64) {
+        const double *values = items;
+        double minValue = *(double *) min;
+        double maxValue = *(double *) max;
+        for (uint32_t i = from; i < size; i++) {
+            minValue = values[i] < minValue ? values[i] : minValue;
+            maxValue = values[i] > maxValue ? values[i] : maxValue;
+        }
+        *(double *) min = minValue;
+        *(double *) max = maxValue;
+    } else {
+        const uint32_t *values = items;
+        bool isSigned = kind == VECTOR_ELEMENT_I32;
+        uint32_t minValue = *(uint32_t *) min;
+        uint32_t maxValue = *(uint32_t *) max;
+        for (uint32_t i = from; i < size; i++) {
+            minValue = isLess32(values[i], minValue, isSigned) ? values[i] : minValue;
+            maxValue = isLess32(maxValue, values[i], isSigned) ? values[i] : maxValue;
+        }
+        *(uint32_t *) min = minValue;
+        *(uint32_t *) max = maxValue;
+    }
+}
+
+static uint64_t sum32(const uint32_t *items, uint32_t from, uint32_t size, bool isSigned, uint64_t sum) {
+    for (uint32_t i = from; i < size; i++) {
+        sum += isSigned ? (uint64_t) (int64_t) (int32_t) items[i] : items[i];   // two's complement wraps to signed sum
+    }
+    return sum;
+}
+
+static double sumFloat(const void *items, uint32_t from, uint32_t size, VectorElementKind kind, double sum) {
+    for (uint32_t i = from; i < size; i++) {
+        sum += kind == VECTOR_ELEMENT_F32 ? (double) ((const float *) items)[i] : ((const double *) items)[i];
+    }
+    return sum;
+}
+
+#ifdef VECTOR_KERNELS_AVX2
+AVX2_FUNCTION static void minMax32Avx2(const void *items, uint32_t size, VectorElementKind kind, void *min, void *max) {
+    uint32_t i = 0;
+    if (kind == VECTOR_ELEMENT_F64) {
+        const double *values = items;
+        __m256d minValues = _mm256_set1_pd(values[0]);
+        __m256d maxValues = minValues;
+        for (; i + 4 <= size; i += 4) {
+            __m256d block = _mm256_loadu_pd(values + i);
+            minValues = _mm256_min_pd(minValues, block);
+            maxValues = _mm256_max_pd(maxValues, block);
+        }
+        double minLanes[4], maxLanes[4];
+        _mm256_storeu_pd(minLanes, minValues);
+        _mm256_storeu_pd(maxLanes, maxValues);
+        minMax32(minLanes, 0, 4, kind, min, max);
+        minMax32(maxLanes, 0, 4, kind, min, max);
+    } else {
+        __m256i minValues = _mm256_set1_epi32(*(const int32_t *) items);
+        __m256i maxValues = minValues;
+        for (; i + 8 <= size; i += 8) {
+            __m256i block = _mm256_loadu_si256((const __m256i *) ((const uint32_t *) items + i));
+            if (kind == VECTOR_ELEMENT_F32) {
+                minValues = _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(minValues), _mm256_castsi256_ps(block)));
+                maxValues = _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(maxValues), _mm256_castsi256_ps(block)));
+            } else if (kind == VECTOR_ELEMENT_I32) {
+                minValues = _mm256_min_epi32(minValues, block);
+                maxValues = _mm256_max_epi32(maxValues, block);
+            } else {
+                minValues = _mm256_min_epu32(minValues, block);
+                maxValues = _mm256_max_epu32(maxValues, block);
+            }
+        }
+        uint32_t minLanes[8], maxLanes[8];
+        _mm256_storeu_si256((__m256i *) minLanes, minValues);
+        _mm256_storeu_si256((__m256i *) maxLanes, maxValues);
+        minMax32(minLanes, 0, 8, kind, min, max);
+        minMax32(maxLanes, 0, 8, kind, min, max);
+    }
+    minMax32(items, i, size, kind, min, max);
+}
+
+AVX2_FUNCTION static uint64_t sum32Avx2(const uint32_t *items, uint32_t size, bool isSigned) {
+    __m256i sums[2] = {_mm256_setzero_si256(), _mm256_setzero_si256()};
+    uint32_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        __m128i low = _mm_loadu_si128((const __m128i *) (items + i));
+        __m128i high = _mm_loadu_si128((const __m128i *) (items + i + 4));
+        if (isSigned) {
+            sums[0] = _mm256_add_epi64(sums[0], _mm256_cvtepi32_epi64(low));
+            sums[1] = _mm256_add_epi64(sums[1], _mm256_cvtepi32_epi64(high));
+        } else {
+            sums[0] = _mm256_add_epi64(sums[0], _mm256_cvtepu32_epi64(low));
+            sums[1] = _mm256_add_epi64(sums[1], _mm256_cvtepu32_epi64(high));
+        }
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *) lanes, _mm256_add_epi64(sums[0], sums[1]));
+    return sum32(items, i, size, isSigned, lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+}
+
+AVX2_FUNCTION static double sumFloatAvx2(const void *items, uint32_t size, VectorElementKind kind) {
+    __m256d sums[2] = {_mm256_setzero_pd(), _mm256_setzero_pd()};
+    uint32_t i = 0;
+    for (; i + 8 <= size; i += 8) {     // two independent accumulators hide addition latency
+        if (kind == VECTOR_ELEMENT_F32) {
+            const float *values = (const float *) items + i;
+            sums[0] = _mm256_add_pd(sums[0], _mm256_cvtps_pd(_mm_loadu_ps(values)));
+            sums[1] = _mm256_add_pd(sums[1], _mm256_cvtps_pd(_mm_loadu_ps(values + 4)));
+        } else {
+            const double *values = (const double *) items + i;
+            sums[0] = _mm256_add_pd(sums[0], _mm256_loadu_pd(values));
+            sums[1] = _mm256_add_pd(sums[1], _mm256_loadu_pd(values + 4));
+        }
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(sums[0], sums[1]));
+    return sumFloat(items, i, size, kind, (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+}
+#endif
+
+void vectorKernelMinMax(const void *items, uint32_t size, VectorElementKind kind, void *min, void *max) {
+    size_t elementSize = kind == VECTOR_ELEMENT_F64 ? sizeof(double) : sizeof(uint32_t);
+    memcpy(min, items, elementSize);
+    memcpy(max, items, elementSize);
+#ifdef VECTOR_KERNELS_AVX2
+    if (isAvx2Supported()) {
+        minMax32Avx2(items, size, kind, min, max);
+        return;
+    }
+#endif
+    uint32_t i = 0;
+#if defined(__SSE2__)
+    if (kind == VECTOR_ELEMENT_F32) {
+        __m128 minValues = _mm_set1_ps(*(const float *) items);
+        __m128 maxValues = minValues;
+        for (; i + 4 <= size; i += 4) {
+            __m128 block = _mm_loadu_ps((const float *) items + i);
+            minValues = _mm_min_ps(minValues, block);
+            maxValues = _mm_max_ps(maxValues, block);
+        }
+        float minLanes[4], maxLanes[4];
+        _mm_storeu_ps(minLanes, minValues);
+        _mm_storeu_ps(maxLanes, maxValues);
+        minMax32(minLanes, 0, 4, kind, min, max);
+        minMax32(maxLanes, 0, 4, kind, min, max);
+    } else if (kind == VECTOR_ELEMENT_F64) {
+        __m128d minValues = _mm_set1_pd(*(const double *) items);
+        __m128d maxValues = minValues;
+        for (; i + 2 <= size; i += 2) {
+            __m128d block = _mm_loadu_pd((const double *) items + i);
+            minValues = _mm_min_pd(minValues, block);
+            maxValues = _mm_max_pd(maxValues, block);
+        }
+        double minLanes[2], maxLanes[2];
+        _mm_storeu_pd(minLanes, minValues);
+        _mm_storeu_pd(maxLanes, maxValues);
+        minMax32(minLanes, 0, 2, kind, min, max);
+        minMax32(maxLanes, 0, 2, kind, min, max);
+    }
+#endif
+    minMax32(items, i, size, kind, min, max);
+}
+
+uint64_t vectorKernelSum32(const void *items, uint32_t size, bool isSigned) {
+#ifdef VECTOR_KERNELS_AVX2
+    if (isAvx2Supported()) {
+        return sum32Avx2(items, size, isSigned);
+    }
+#endif
+    uint32_t i = 0;
+    uint64_t sum = 0;
+#if defined(__SSE2__)
+    __m128i sums = _mm_setzero_si128();
+    for (; i + 4 <= size; i += 4) {
+        __m128i block = _mm_loadu_si128((const __m128i *) ((const uint32_t *) items + i));
+        __m128i high = isSigned ? _mm_cmpgt_epi32(_mm_setzero_si128(), block) : _mm_setzero_si128();  // sign extension
+        sums = _mm_add_epi64(sums, _mm_unpacklo_epi32(block, high));
+        sums = _mm_add_epi64(sums, _mm_unpackhi_epi32(block, high));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i *) lanes, sums);
+    sum = lanes[0] + lanes[1];
+#endif
+    return sum32(items, i, size, isSigned, sum);
+}
+
+double vectorKernelSumFloat(const void *items, uint32_t size, VectorElementKind kind) {
+#ifdef VECTOR_KERNELS_AVX2
+    if (isAvx2Supported()) {
+        return sumFloatAvx2(items, size, kind);
+    }
+#endif
+    uint32_t i = 0;
+    double sum = 0;
+#if defined(__SSE2__)
+    __m128d sums = _mm_setzero_pd();
+    for (; i + 2 <= size; i += 2) {
+        __m128d block = kind == VECTOR_ELEMENT_F32 ?
+                        _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i *) ((const float *) items + i)))) :
+                        _mm_loadu_pd((const double *) items + i);
+        sums = _mm_add_pd(sums, block);
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, sums);
+    sum = lanes[0] + lanes[1];
+#endif
+    return sumFloat(items, i, size, kind, sum);
+}
+
+static void axpyFloat(void *y, const void *x, uint32_t from, uint32_t size, VectorElementKind kind, double alpha) {
+    if (kind == VECTOR_ELEMENT_F32) {
+        float *one = y;
+        const float *two = x;
+        for (uint32_t i = from; i < size; i++) {
+            one[i] += (float) alpha * two[i];
+        }
+    } else {
+        double *one = y;
+        const double *two = x;
+        for (uint32_t i = from; i < size; i++) {
+            one[i] += alpha * two[i];
+        }
+    }
+}
+
+static void multiplyFloat(void *dest, const void *source, uint32_t from, uint32_t size, VectorElementKind kind) {
+    if (kind == VECTOR_ELEMENT_F32) {
+        for (uint32_t i = from; i < size; i++) {
+            ((float *) dest)[i] *= ((const float *) source)[i];
+        }
+    } else {
+        for (uint32_t i = from; i < size; i++) {
+            ((double *) dest)[i] *= ((const double *) source)[i];
+        }
+    }
+}
+
+static double dotFloat(const void *first, const void *second, uint32_t from, uint32_t size, VectorElementKind kind, double sum) {
+    for (uint32_t i = from; i < size; i++) {
+        sum += kind == VECTOR_ELEMENT_F32 ?
+               (double) ((const float *) first)[i] * ((const float *) second)[i] :
+               ((const double *) first)[i] * ((const double *) second)[i];
+    }
+    return sum;
+}
+
+#ifdef VECTOR_KERNELS_AVX2
+FMA_FUNCTION static void axpyFloatFma(void *y, const void *x, uint32_t size, VectorElementKind kind, double alpha) {
+    uint32_t i = 0;
+    if (kind == VECTOR_ELEMENT_F32) {
+        __m256 factor = _mm256_set1_ps((float) alpha);
+        for (; i + 8 <= size; i += 8) {
+            float *one = (float *) y + i;
+            _mm256_storeu_ps(one, _mm256_fmadd_ps(factor, _mm256_loadu_ps((const float *) x + i), _mm256_loadu_ps(one)));
+        }
+    } else {
+        __m256d factor = _mm256_set1_pd(alpha);
+        for (; i + 4 <= size; i += 4) {
+            double *one = (double *) y + i;
+            _mm256_storeu_pd(one, _mm256_fmadd_pd(factor, _mm256_loadu_pd((const double *) x + i), _mm256_loadu_pd(one)));
+        }
+    }
+    axpyFloat(y, x, i, size, kind, alpha);
+}
+
+AVX2_FUNCTION static void multiplyFloatAvx2(void *dest, const void *source, uint32_t size, VectorElementKind kind) {
+    uint32_t i = 0;
+    if (kind == VECTOR_ELEMENT_F32) {
+        for (; i + 8 <= size; i += 8) {
+            float *one = (float *) dest + i;
+            _mm256_storeu_ps(one, _mm256_mul_ps(_mm256_loadu_ps(one), _mm256_loadu_ps((const float *) source + i)));
+        }
+    } else {
+        for (; i + 4 <= size; i += 4) {
+            double *one = (double *) dest + i;
+            _mm256_storeu_pd(one, _mm256_mul_pd(_mm256_loadu_pd(one), _mm256_loadu_pd((const double *) source + i)));
+        }
+    }
+    multiplyFloat(dest, source, i, size, kind);
+}
+
+FMA_FUNCTION static double dotFloatFma(const void *first, const void *second, uint32_t size, VectorElementKind kind) {
+    uint32_t i = 0;
+    double sum;
+    if (kind == VECTOR_ELEMENT_F32) {   // widened to double lanes like scalar tail, two accumulators hide FMA latency
+        __m256d sums[2] = {_mm256_setzero_pd(), _mm256_setzero_pd()};
+        for (; i + 8 <= size; i += 8) {
+            __m256 one = _mm256_loadu_ps((const float *) first + i);
+            __m256 two = _mm256_loadu_ps((const float *) second + i);
+            sums[0] = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(one)), _mm256_cvtps_pd(_mm256_castps256_ps128(two)), sums[0]);
+            sums[1] = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(one, 1)), _mm256_cvtps_pd(_mm256_extractf128_ps(two, 1)), sums[1]);
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, _mm256_add_pd(sums[0], sums[1]));
+        sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    } else {
+        __m256d sums[2] = {_mm256_setzero_pd(), _mm256_setzero_pd()};
+        for (; i + 8 <= size; i += 8) {
+            const double *one = (const double *) first + i;
+            const double *two = (const double *) second + i;
+            sums[0] = _mm256_fmadd_pd(_mm256_loadu_pd(one), _mm256_loadu_pd(two), sums[0]);
+            sums[1] = _mm256_fmadd_pd(_mm256_loadu_pd(one + 4), _mm256_loadu_pd(two + 4), sums[1]);
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, _mm256_add_pd(sums[0], sums[1]));
+        sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+    return dotFloat(first, second, i, size, kind, sum);
+}
+#endif
+
+void vectorKernelAxpy(void *y, const void *x, uint32_t size, VectorElementKind kind, double alpha) {
+#ifdef VECTOR_KERNELS_AVX2
+    if (isFmaSupported()) {
+        axpyFloatFma(y, x, size, kind, alpha);
+        return;
+    }
+#endif
+    uint32_t i = 0;
+#if defined(__SSE2__)
+    if (kind == VECTOR_ELEMENT_F32) {
+        __m128 factor = _mm_set1_ps((float) alpha);
+        for (; i + 4 <= size; i += 4) {
+            float *one = (float *) y + i;
+            _mm_storeu_ps(one, _mm_add_ps(_mm_loadu_ps(one), _mm_mul_ps(factor, _mm_loadu_ps((const float *) x + i))));
+        }
+    } else {
+        __m128d factor = _mm_set1_pd(alpha);
+        for (; i + 2 <= size; i += 2) {
+            double *one = (double *) y + i;
+            _mm_storeu_pd(one, _mm_add_pd(_mm_loadu_pd(one), _mm_mul_pd(factor, _mm_loadu_pd((const double *) x + i))));
+        }
+    }
+#endif
+    axpyFloat(y, x, i, size, kind, alpha);
+}
+
+void vectorKernelMultiply(void *dest, const void *source, uint32_t size, VectorElementKind kind) {
+#ifdef VECTOR_KERNELS_AVX2
+    if (isAvx2Supported()) {
+        multiplyFloatAvx2(dest, source, size, kind);
+        return;
+    }
+#endif
+    uint32_t i = 0;
+#if defined(__SSE2__)
+    if (kind == VECTOR_ELEMENT_F32) {
+        for (; i + 4 <= size; i += 4) {
+            float *one = (float *) dest + i;
+            _mm_storeu_ps(one, _mm_mul_ps(_mm_loadu_ps(one), _mm_loadu_ps((const float *) source + i)));
+        }
+    } else {
+        for (; i + 2 <= size; i += 2) {
+            double *one = (double *) dest + i;
+            _mm_storeu_pd(one, _mm_mul_pd(_mm_loadu_pd(one), _mm_loadu_pd((const double *) source + i)));
+        }
+    }
+#endif
+    multiplyFloat(dest, source, i, size, kind);
+}
+
+double vectorKernelDot(const void *first, const void *second, uint32_t size, VectorElementKind kind) {
+#ifdef VECTOR_KERNELS_AVX2
+    if (isFmaSupported()) {
+        return dotFloatFma(first, second, size, kind);
+    }
+#endif
+    uint32_t i = 0;
+    double sum = 0;
+#if defined(__SSE2__)
+    if (kind == VECTOR_ELEMENT_F32) {   // float pairs are widened, products and sums stay in double
+        __m128d sums[2] = {_mm_setzero_pd(), _mm_setzero_pd()};
+        for (; i + 4 <= size; i += 4) {
+            __m128 one = _mm_loadu_ps((const float *) first + i);
+            __m128 two = _mm_loadu_ps((const float *) second + i);
+            sums[0] = _mm_add_pd(sums[0], _mm_mul_pd(_mm_cvtps_pd(one), _mm_cvtps_pd(two)));
+            sums[1] = _mm_add_pd(sums[1], _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(one, one)), _mm_cvtps_pd(_mm_movehl_ps(two, two))));
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, _mm_add_pd(sums[0], sums[1]));
+        sum = lanes[0] + lanes[1];
+    } else {
+        __m128d sums = _mm_setzero_pd();
+        for (; i + 2 <= size; i += 2) {
+            sums = _mm_add_pd(sums, _mm_mul_pd(_mm_loadu_pd((const double *) first + i), _mm_loadu_pd((const double *) second + i)));
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, sums);
+        sum = lanes[0] + lanes[1];
+    }
+#endif
+    return dotFloat(first, second, i, size, kind, sum);
+}
+
+void vectorKernelScale(void *items, uint32_t size, VectorElementKind kind, double factor) {
+    uint32_t i = 0;
+    if (kind == VECTOR_ELEMENT_F32) {
+        float *values = items;
+#if defined(__SSE2__)
+        __m128 factors = _mm_set1_ps((float) factor);
+        for (; i + 4 <= size; i += 4) {
+            _mm_storeu_ps(values + i, _mm_mul_ps(_mm_loadu_ps(values + i), factors));
+        }
+#endif
+        for (; i < size; i++) {
+            values[i] *= (float) factor;
+        }
+    } else {
+        double *values = items;
+#if defined(__SSE2__)
+        __m128d factors = _mm_set1_pd(factor);
+        for (; i + 2 <= size; i += 2) {
+            _mm_storeu_pd(values + i, _mm_mul_pd(_mm_loadu_pd(values + i), factors));
+        }
+#endif
+        for (; i < size; i++) {
+            values[i] *= factor;
+        }
+    }
+}
+
+uint32_t vectorKernelScan32(void *items, uint32_t size, bool isExclusive, uint32_t offset) {
+    uint32_t *values = items;
+    uint32_t sum = offset;
+    uint32_t i = 0;
+#if defined(__SSE2__)
+    __m128i carry = _mm_set1_epi32((int32_t) offset);
+    for (; i + 4 <= size; i += 4) {     // in-register Hillis-Steele scan, carry holds running total in every lane
+        __m128i block = _mm_loadu_si128((const __m128i *) (values + i));
+        __m128i scan = _mm_add_epi32(block, _mm_slli_si128(block, 4));
+        scan = _mm_add_epi32(scan, _mm_slli_si128(scan, 8));
+        scan = _mm_add_epi32(scan, carry);
+        _mm_storeu_si128((__m128i *) (values + i), isExclusive ? _mm_sub_epi32(scan, block) : scan);
+        carry = _mm_shuffle_epi32(scan, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    sum = (uint32_t) _mm_cvtsi128_si32(carry);
+#endif
+    for (; i < size; i++) {     // unsigned addition wraps same way as signed two's complement
+        uint32_t value = values[i];
+        sum += value;
+        values[i] = isExclusive ? sum - value : sum;
+    }
+    return sum;
+}
+
+void vectorKernelHistogram8(const void *items, uint32_t size, bool isSigned, uint32_t *counts, uint32_t countsLength) {
+    uint32_t tables[4][256];    // separate tables, so repeated values don't serialize on the same counter
+    memset(tables, 0, sizeof(tables));
+    const uint8_t *bytes = items;
+    uint32_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        tables[0][bytes[i]]++;
+        tables[1][bytes[i + 1]]++;
+        tables[2][bytes[i + 2]]++;
+        tables[3][bytes[i + 3]]++;
+    }
+    for (; i < size; i++) {
+        tables[0][bytes[i]]++;
+    }
+
+    memset(counts, 0, sizeof(uint32_t) * countsLength);
+    for (uint32_t byte = 0; byte < 256; byte++) {
+        int32_t value = isSigned ? (int8_t) byte : (int32_t) byte;
+        if (value >= 0 && (uint32_t) value < countsLength) {
+            counts[value] = tables[0][byte] + tables[1][byte] + tables[2][byte] + tables[3][byte];
+        }
+    }
+}
+
+#define COUNTING_STACK_COUNTERS 256     // larger value ranges allocate counters on heap
+#define COUNTING_RANGE_PER_ITEM 4       // wider value ranges are left to comparison sort
+
+static inline int32_t readNarrow(const void *items, uint32_t index, VectorElementKind kind) {
+    switch (kind) {
+        case VECTOR_ELEMENT_I8:
+            return ((const int8_t *) items)[index];
+        case VECTOR_ELEMENT_U8:
+            return ((const uint8_t *) items)[index];
+        case VECTOR_ELEMENT_I16:
+            return ((const int16_t *) items)[index];
+        default:
+            return ((const uint16_t *) items)[index];
+    }
+}
+
+static inline void writeNarrow(void *items, uint32_t index, VectorElementKind kind, int32_t value) {
+    switch (kind) {
+        case VECTOR_ELEMENT_I8:
+            ((int8_t *) items)[index] = (int8_t) value;
+            break;
+        case VECTOR_ELEMENT_U8:
+            ((uint8_t *) items)[index] = (uint8_t) value;
+            break;
+        case VECTOR_ELEMENT_I16:
+            ((int16_t *) items)[index] = (int16_t) value;
+            break;
+        default:
+            ((uint16_t *) items)[index] = (uint16_t) value;
+    }
+}
+
+static void narrowRange(const void *items, uint32_t size, VectorElementKind kind, int32_t *min, int32_t *max) {
+    for (uint32_t i = 0; i < size; i++) {
+        int32_t value = readNarrow(items, i, kind);
+        *min = value < *min ? value : *min;
+        *max = value > *max ? value : *max;
+    }
+}
+
+uint32_t vectorKernelCountingOperation(void *items, uint32_t size, const void *source, uint32_t sourceSize,
+                                       VectorElementKind kind, VectorCountingOperation operation) {
+    bool isPair = operation == VECTOR_COUNTING_INTERSECT || operation == VECTOR_COUNTING_SUBTRACT;
+    if (!isPair) {
+        sourceSize = 0;
+    }
+    if (size == 0) return 0;
+
+    int32_t min = INT32_MAX;
+    int32_t max = INT32_MIN;
+    narrowRange(items, size, kind, &min, &max);
+    narrowRange(source, sourceSize, kind, &min, &max);
+    uint32_t range = (uint32_t) (max - min) + 1;
+    if (range > COUNTING_RANGE_PER_ITEM * (uint64_t) (size + sourceSize)) return VECTOR_KERNEL_RANGE_TOO_WIDE;
+
+    uint32_t stackCounts[COUNTING_STACK_COUNTERS];
+    size_t counterCount = isPair ? 2 * (size_t) range : range;
+    uint32_t *counts = counterCount <= COUNTING_STACK_COUNTERS ? stackCounts : malloc(sizeof(uint32_t) * counterCount);
+    if (counts == NULL) return VECTOR_KERNEL_NO_MEMORY;
+    memset(counts, 0, sizeof(uint32_t) * counterCount);
+    uint32_t *sourceCounts = counts + range;    // only used by operations with source
+
+    for (uint32_t i = 0; i < size; i++) {
+        counts[readNarrow(items, i, kind) - min]++;
+    }
+    for (uint32_t i = 0; i < sourceSize; i++) {
+        sourceCounts[readNarrow(source, i, kind) - min]++;
+    }
+
+    uint32_t index = 0;
+    for (uint32_t key = 0; key < range; key++) {
+        uint32_t count = counts[key];
+        switch (operation) {
+            case VECTOR_COUNTING_UNIQUE:
+                count = count > 0;
+                break;
+            case VECTOR_COUNTING_SINGLE:
+                count = count == 1;
+                break;
+            case VECTOR_COUNTING_INTERSECT:
+                count = count > 0 && sourceCounts[key] > 0;
+                break;
+            case VECTOR_COUNTING_SUBTRACT:
+                count = count > sourceCounts[key] ? count - sourceCounts[key] : 0;
+                break;
+            default:
+                break;
+        }
+        for (; count > 0; count--) {    // result never outgrows input, counts are already taken
+            writeNarrow(items, index++, kind, (int32_t) key + min);
+        }
+    }
+
+    if (counts != stackCounts) {
+        free(counts);
+    }
+    return index;
+}
+
+// Comparator pairs of sorting networks for 2..16 elements, size-optimal up to 8 elements, Batcher odd-even merge derived above
+static const uint8_t SORT_NETWORK_PAIRS[] = {
+        /*  2 */
+        0, 1,
+        /*  3 */
+        0, 2, 0, 1, 1, 2,
+        /*  4 */
+        0, 1, 2, 3, 0, 2, 1, 3, 1, 2,
+        /*  5 */
+        0, 3, 1, 4, 0, 2, 1, 3, 0, 1, 2, 4, 1, 2, 3, 4, 2, 3,
+        /*  6 */
+        0, 5, 1, 3, 2, 4, 1, 2, 3, 4, 0, 3, 2, 5, 0, 1, 2, 3, 4, 5, 1, 2, 3, 4,
+        /*  7 */
+        0, 1, 2, 3, 4, 5, 0, 2, 1, 3, 4, 6, 1, 2, 5, 6, 0, 4, 1, 5, 2, 6, 2, 4, 3, 5, 1, 2, 3, 4, 5, 6,
+        /*  8 */
+        0, 1, 2, 3, 4, 5, 6, 7, 0, 2, 1, 3, 4, 6, 5, 7, 1, 2, 5, 6, 0, 4, 1, 5, 2, 6, 3, 7, 2, 4, 3, 5, 1, 2, 3, 4,
+        5, 6,
+        /*  9 */
+        0, 1, 2, 3, 4, 5, 6, 7, 0, 2, 1, 3, 4, 6, 5, 7, 1, 2, 5, 6, 0, 4, 1, 5, 2, 6, 3, 7, 2, 4, 3, 5, 1, 2, 3, 4,
+        5, 6, 0, 8, 4, 8, 2, 4, 6, 8, 1, 2, 3, 4, 5, 6, 7, 8,
+        /* 10 */
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 2, 1, 3, 4, 6, 5, 7, 1, 2, 5, 6, 0, 4, 1, 5, 2, 6, 3, 7, 2, 4, 3, 5, 1, 2,
+        3, 4, 5, 6, 0, 8, 1, 9, 4, 8, 5, 9, 2, 4, 3, 5, 6, 8, 7, 9, 1, 2, 3, 4, 5, 6, 7, 8,
+        /* 11 */
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 2, 1, 3, 4, 6, 5, 7, 8, 10, 1, 2, 5, 6, 9, 10, 0, 4, 1, 5, 2, 6, 3, 7, 2, 4,
+        3, 5, 1, 2, 3, 4, 5, 6, 0, 8, 1, 9, 2, 10, 4, 8, 5, 9, 6, 10, 2, 4, 3, 5, 6, 8, 7, 9, 1, 2, 3, 4, 5, 6, 7, 8,
+        9, 10,
+        /* 12 */
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 2, 1, 3, 4, 6, 5, 7, 8, 10, 9, 11, 1, 2, 5, 6, 9, 10, 0, 4, 1, 5,
+        2, 6, 3, 7, 2, 4, 3, 5, 1, 2, 3, 4, 5, 6, 0, 8, 1, 9, 2, 10, 3, 11, 4, 8, 5, 9, 6, 10, 7, 11, 2, 4, 3, 5, 6, 8,
+        7, 9, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+        /* 13 */
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 2, 1, 3, 4, 6, 5, 7, 8, 10, 9, 11, 1, 2, 5, 6, 9, 10, 0, 4, 1, 5,
+        2, 6, 3, 7, 8, 12, 2, 4, 3, 5, 10, 12, 1, 2, 3, 4, 5, 6, 9, 10, 11, 12, 0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 4, 8,
+        5, 9, 6, 10, 7, 11, 2, 4, 3, 5, 6, 8, 7, 9, 10, 12, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+        /* 14 */
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 0, 2, 1, 3, 4, 6, 5, 7, 8, 10, 9, 11, 1, 2, 5, 6, 9, 10, 0, 4,
+        1, 5, 2, 6, 3, 7, 8, 12, 9, 13, 2, 4, 3, 5, 10, 12, 11, 13, 1, 2, 3, 4, 5, 6, 9, 10, 11, 12, 0, 8, 1, 9, 2, 10,
+        3, 11, 4, 12, 5, 13, 4, 8, 5, 9, 6, 10, 7, 11, 2, 4, 3, 5, 6, 8, 7, 9, 10, 12, 11, 13, 1, 2, 3, 4, 5, 6, 7, 8,
+        9, 10, 11, 12,
+        /* 15 */
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 0, 2, 1, 3, 4, 6, 5, 7, 8, 10, 9, 11, 12, 14, 1, 2, 5, 6, 9, 10,
+        13, 14, 0, 4, 1, 5, 2, 6, 3, 7, 8, 12, 9, 13, 10, 14, 2, 4, 3, 5, 10, 12, 11, 13, 1, 2, 3, 4, 5, 6, 9, 10,
+        11, 12, 13, 14, 0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 4, 8, 5, 9, 6, 10, 7, 11, 2, 4, 3, 5, 6, 8,
+        7, 9, 10, 12, 11, 13, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+        /* 16 */
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 2, 1, 3, 4, 6, 5, 7, 8, 10, 9, 11, 12, 14, 13, 15,
+        1, 2, 5, 6, 9, 10, 13, 14, 0, 4, 1, 5, 2, 6, 3, 7, 8, 12, 9, 13, 10, 14, 11, 15, 2, 4, 3, 5, 10, 12, 11, 13,
+        1, 2, 3, 4, 5, 6, 9, 10, 11, 12, 13, 14, 0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15, 4, 8, 5, 9,
+        6, 10, 7, 11, 2, 4, 3, 5, 6, 8, 7, 9, 10, 12, 11, 13, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14
+};
+
+static const uint16_t SORT_NETWORK_OFFSETS[] = {  // start of each network in pairs array, indexed by element count
+        0, 0, 0, 2, 8, 18, 36, 60, 92, 130, 184, 248, 322, 404, 500, 606, 724, 850
+};
+
+
+#ifdef VECTOR_KERNELS_AVX2
+// In-register bitonic sort of 16 lanes held in two registers: partner lane indexes and 'take max' lane masks of each step.
+// Step (16, 8) compares registers with each other and is applied separately
+static const int32_t BITONIC_PARTNERS[9][8] = {
+        {1, 0, 3, 2, 5, 4, 7, 6},
+        {2, 3, 0, 1, 6, 7, 4, 5},
+        {1, 0, 3, 2, 5, 4, 7, 6},
+        {4, 5, 6, 7, 0, 1, 2, 3},
+        {2, 3, 0, 1, 6, 7, 4, 5},
+        {1, 0, 3, 2, 5, 4, 7, 6},
+        {4, 5, 6, 7, 0, 1, 2, 3},
+        {2, 3, 0, 1, 6, 7, 4, 5},
+        {1, 0, 3, 2, 5, 4, 7, 6},
+};
+
+static const int32_t BITONIC_MAX_LOW[9][8] = {
+        {0, -1, -1, 0, 0, -1, -1, 0},
+        {0, 0, -1, -1, -1, -1, 0, 0},
+        {0, -1, 0, -1, -1, 0, -1, 0},
+        {0, 0, 0, 0, -1, -1, -1, -1},
+        {0, 0, -1, -1, 0, 0, -1, -1},
+        {0, -1, 0, -1, 0, -1, 0, -1},
+        {0, 0, 0, 0, -1, -1, -1, -1},
+        {0, 0, -1, -1, 0, 0, -1, -1},
+        {0, -1, 0, -1, 0, -1, 0, -1},
+};
+
+static const int32_t BITONIC_MAX_HIGH[9][8] = {
+        {0, -1, -1, 0, 0, -1, -1, 0},
+        {0, 0, -1, -1, -1, -1, 0, 0},
+        {0, -1, 0, -1, -1, 0, -1, 0},
+        {-1, -1, -1, -1, 0, 0, 0, 0},
+        {-1, -1, 0, 0, -1, -1, 0, 0},
+        {-1, 0, -1, 0, -1, 0, -1, 0},
+        {0, 0, 0, 0, -1, -1, -1, -1},
+        {0, 0, -1, -1, 0, 0, -1, -1},
+        {0, -1, 0, -1, 0, -1, 0, -1},
+};
+
+AVX2_FUNCTION static inline __m256i bitonicStep(__m256i values, uint32_t step, const int32_t (*maxMasks)[8]) {
+    __m256i partner = _mm256_permutevar8x32_epi32(values, _mm256_loadu_si256((const __m256i *) BITONIC_PARTNERS[step]));
+    __m256i mask = _mm256_loadu_si256((const __m256i *) maxMasks[step]);
+    return _mm256_blendv_epi8(_mm256_min_epi32(values, partner), _mm256_max_epi32(values, partner), mask);
+}
+
+AVX2_FUNCTION static void sortSmall32Avx2(int32_t keys[16], uint32_t size) {
+    __m256i low = _mm256_loadu_si256((const __m256i *) keys);
+    if (size <= 8) {
+        for (uint32_t step = 0; step < 6; step++) {
+            low = bitonicStep(low, step, BITONIC_MAX_LOW);
+        }
+        _mm256_storeu_si256((__m256i *) keys, low);
+        return;
+    }
+
+    __m256i high = _mm256_loadu_si256((const __m256i *) (keys + 8));
+    for (uint32_t step = 0; step < 6; step++) {     // low half ascending, high half descending
+        low = bitonicStep(low, step, BITONIC_MAX_LOW);
+        high = bitonicStep(high, step, BITONIC_MAX_HIGH);
+    }
+    __m256i min = _mm256_min_epi32(low, high);
+    high = _mm256_max_epi32(low, high);
+    low = min;
+    for (uint32_t step = 6; step < 9; step++) {
+        low = bitonicStep(low, step, BITONIC_MAX_LOW);
+        high = bitonicStep(high, step, BITONIC_MAX_HIGH);
+    }
+    _mm256_storeu_si256((__m256i *) keys, low);
+    _mm256_storeu_si256((__m256i *) (keys + 8), high);
+}
+#endif
+
+static inline int32_t orderKey32(uint32_t bits, VectorElementKind kind) {     // maps value to signed integer with same order
+    if (kind == VECTOR_ELEMENT_U32) return (int32_t) (bits ^ 0x80000000u);
+    if (kind == VECTOR_ELEMENT_F32) return (int32_t) (bits ^ ((uint32_t) ((int32_t) bits >> 31) & 0x7FFFFFFFu));
+    return (int32_t) bits;
+}
+
+const uint8_t *vectorSortNetwork(uint32_t size, uint32_t *pairCount) {
+    if (size > VECTOR_SORT_NETWORK_MAX) {
+        *pairCount = 0;
+        return NULL;
+    }
+    *pairCount = (uint32_t) (SORT_NETWORK_OFFSETS[size + 1] - SORT_NETWORK_OFFSETS[size]) / 2;
+    return SORT_NETWORK_PAIRS + SORT_NETWORK_OFFSETS[size];
+}
+
+bool vectorKernelSortSmall32(void *items, uint32_t size, VectorElementKind kind) {
+#ifdef VECTOR_KERNELS_AVX2
+    if (size > 2 * VECTOR_SORT_NETWORK_MAX || !isAvx2Supported()) return false;
+    uint32_t *values = items;
+    int32_t keys[2 * VECTOR_SORT_NETWORK_MAX];
+    for (uint32_t i = 0; i < size; i++) {
+        if (kind == VECTOR_ELEMENT_F32 && (values[i] & 0x7FFFFFFFu) > 0x7F800000u) return false;  // NaN is left to comparator
+        keys[i] = orderKey32(values[i], kind);
+    }
+    for (uint32_t i = size; i < 2 * VECTOR_SORT_NETWORK_MAX; i++) {
+        keys[i] = INT32_MAX;    // padding stays at the end
+    }
+    sortSmall32Avx2(keys, size < VECTOR_SORT_NETWORK_MAX ? size : VECTOR_SORT_NETWORK_MAX);
+    if (size <= VECTOR_SORT_NETWORK_MAX) {
+        for (uint32_t i = 0; i < size; i++) {
+            values[i] = (uint32_t) orderKey32((uint32_t) keys[i], kind);   // key mapping is its own inverse
+        }
+        return true;
+    }
+
+    sortSmall32Avx2(keys + VECTOR_SORT_NETWORK_MAX, size - VECTOR_SORT_NETWORK_MAX);
+    uint32_t i = 0;
+    uint32_t j = VECTOR_SORT_NETWORK_MAX;
+    for (uint32_t k = 0; k < size; k++) {   // branchless merge of sorted halves, padding is never taken before real keys
+        bool isFirst = j >= size || (i < VECTOR_SORT_NETWORK_MAX && keys[i] <= keys[j]);
+        values[k] = (uint32_t) orderKey32((uint32_t) (isFirst ? keys[i] : keys[j]), kind);
+        i += isFirst;
+        j += !isFirst;
+    }
+    return true;
+#else
+    (void) items;
+    (void) size;
+    (void) kind;
+    return false;
+#endif
+}
+
+static void gatherScalar(void *dest, const void *source, const uint32_t *indexes, uint32_t from, uint32_t count, uint32_t elementSize) {
+    if (elementSize == sizeof(uint32_t)) {
+        for (uint32_t i = from; i < count; i++) {
+            ((uint32_t *) dest)[i] = ((const uint32_t *) source)[indexes[i]];
+        }
+    } else if (elementSize == sizeof(uint64_t)) {
+        for (uint32_t i = from; i < count; i++) {
+            ((uint64_t *) dest)[i] = ((const uint64_t *) source)[indexes[i]];
+        }
+    } else {
+        for (uint32_t i = from; i < count; i++) {
+            memcpy((uint8_t *) dest + (size_t) i * elementSize, (const uint8_t *) source + (size_t) indexes[i] * elementSize, elementSize);
+        }
+    }
+}
+
+#ifdef VECTOR_KERNELS_AVX2
+AVX2_FUNCTION static uint32_t gatherAvx2(void *dest, const void *source, const uint32_t *indexes, uint32_t count, uint32_t elementSize) {
+    uint32_t i = 0;
+    if (elementSize == sizeof(uint32_t)) {
+        for (; i + 8 <= count; i += 8) {
+            __m256i offsets = _mm256_loadu_si256((const __m256i *) (indexes + i));
+            _mm256_storeu_si256((__m256i *) ((uint32_t *) dest + i), _mm256_i32gather_epi32((const int *) source, offsets, 4));
+        }
+    } else {
+        for (; i + 4 <= count; i += 4) {
+            __m128i offsets = _mm_loadu_si128((const __m128i *) (indexes + i));
+            _mm256_storeu_si256((__m256i *) ((uint64_t *) dest + i), _mm256_i32gather_epi64((const long long *) source, offsets, 8));
+        }
+    }
+    return i;
+}
+#endif
+
+void vectorKernelGather(void *dest, const void *source, uint32_t sourceSize, const uint32_t *indexes, uint32_t count, uint32_t elementSize) {
+    uint32_t i = 0;
+#ifdef VECTOR_KERNELS_AVX2
+    bool isGatherSize = elementSize == sizeof(uint32_t) || elementSize == sizeof(uint64_t);
+    if (isGatherSize && sourceSize <= INT32_MAX && isAvx2Supported()) {  // gather instructions take signed 32-bit offsets
+        i = gatherAvx2(dest, source, indexes, count, elementSize);
+    }
+#else
+    (void) sourceSize;
+#endif
+    gatherScalar(dest, source, indexes, i, count, elementSize);
+}
+
+#define RADIX_BITS 8
+#define RADIX_PASSES (64 / RADIX_BITS)
+
+VectorSortKey *vectorKernelRadixSortKeys(VectorSortKey *keys, VectorSortKey *buffer, uint32_t size) {
+    if (size <= VECTOR_INSERTION_SORT_MAX) {
+        for (uint32_t i = 1; i < size; i++) {
+            VectorSortKey value = keys[i];
+            uint32_t j = i;
+            for (; j > 0 && keys[j - 1].key > value.key; j--) {
+                keys[j] = keys[j - 1];
+            }
+            keys[j] = value;
+        }
+        return keys;
+    }
+
+    uint32_t counts[RADIX_PASSES][1 << RADIX_BITS];     // all digit histograms are built in one read pass
+    memset(counts, 0, sizeof(counts));
+    for (uint32_t i = 0; i < size; i++) {
+        uint64_t key = keys[i].key;
+        for (uint32_t pass = 0; pass < RADIX_PASSES; pass++) {
+            counts[pass][(key >> (pass * RADIX_BITS)) & 0xFF]++;
+        }
+    }
+
+    VectorSortKey *source = keys;
+    VectorSortKey *dest = buffer;
+    for (uint32_t pass = 0; pass < RADIX_PASSES; pass++) {
+        uint32_t shift = pass * RADIX_BITS;
+        if (counts[pass][(source[0].key >> shift) & 0xFF] == size) continue;  // every key has same digit
+
+        uint32_t offset = 0;
+        for (uint32_t digit = 0; digit < (1 << RADIX_BITS); digit++) {
+            uint32_t count = counts[pass][digit];
+            counts[pass][digit] = offset;
+            offset += count;
+        }
+        for (uint32_t i = 0; i < size; i++) {   // stable scatter keeps order of previous passes
+            dest[counts[pass][(source[i].key >> shift) & 0xFF]++] = source[i];
+        }
+        VectorSortKey *tmp = source;
+        source = dest;
+        dest = tmp;
+    }
+    return source;
+}
@@ -0,0 +1,599 @@
+#include "VectorParallel.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#define SAMPLE_SORT_BUCKETS_PER_THREAD 4    // more buckets than threads balances uneven buckets
+#define SAMPLE_SORT_OVERSAMPLING 16         // sampled elements per bucket
+#define MERGE_PATH_MIN_SEGMENT 4096         // shorter segments cost more in split searches than they save
+
+typedef struct SampleSort {
+    uint8_t *items;
+    uint8_t *buffer;            // buckets are scattered here, sorted and copied back
+    uint32_t size;
+    uint32_t elementSize;
+    ParallelComparator comparator;
+    uint8_t *splitters;         // bucketCount - 1 sorted splitters
+    uint32_t bucketCount;
+    uint16_t *bucketOf;         // bucket of every element, classified once
+    uint32_t chunkCount;
+    uint32_t chunkLength;
+    uint32_t *offsets;          // write position of every chunk in every bucket
+    uint32_t *bucketStarts;
+} SampleSort;
+
+typedef struct SampleSortTask {
+    SampleSort *sort;
+    uint32_t index;
+} SampleSortTask;
+
+static inline uint8_t *elementAt(uint8_t *items, uint32_t index, uint32_t elementSize) {
+    return items + (size_t) index * elementSize;
+}
+
+static void chooseSplitters(SampleSort *sort);
+static uint32_t classify(SampleSort *sort, const uint8_t *item);
+static void runPhase(ThreadPool pool, ThreadPoolTask task, void *tasks, size_t taskSize, uint32_t count);
+
+
+static void classifyChunk(void *context) {
+    SampleSortTask *task = context;
+    SampleSort *sort = task->sort;
+    uint32_t *counts = sort->offsets + (size_t) task->index * sort->bucketCount;
+    uint32_t from = task->index * sort->chunkLength;
+    uint32_t to = (task->index + 1 == sort->chunkCount) ? sort->size : from + sort->chunkLength;
+    for (uint32_t i = from; i < to; i++) {
+        uint32_t bucket = classify(sort, elementAt(sort->items, i, sort->elementSize));
+        sort->bucketOf[i] = (uint16_t) bucket;
+        counts[bucket]++;
+    }
+}
+
+static void scatterChunk(void *context) {
+    SampleSortTask *task = context;
+    SampleSort *sort = task->sort;
+    uint32_t *offsets = sort->offsets + (size_t) task->index * sort->bucketCount;
+    uint32_t from = task->index * sort->chunkLength;
+    uint32_t to = (task->index + 1 == sort->chunkCount) ? sort->size : from + sort->chunkLength;
+    for (uint32_t i = from; i < to; i++) {
+        uint32_t position = offsets[sort->bucketOf[i]]++;
+        memcpy(elementAt(sort->buffer, position, sort->elementSize), elementAt(sort->items, i, sort->elementSize), sort->elementSize);
+    }
+}
+
+static void sortBucket(void *context) {
+    SampleSortTask *task = context;
+    SampleSort *sort = task->sort;
+    uint32_t bucket = task->index;
+    uint32_t start = sort->bucketStarts[bucket];
+    uint32_t length = sort->bucketStarts[bucket + 1] - start;
+    uint8_t *items = elementAt(sort->buffer, start, sort->elementSize);
+    bool isEqualBucket = bucket > 0 && bucket + 1 < sort->bucketCount &&   // between two equal splitters
+                         sort->comparator(elementAt(sort->splitters, bucket - 1, sort->elementSize),
+                                          elementAt(sort->splitters, bucket, sort->elementSize)) == 0;
+    if (!isEqualBucket) {
+        qsort(items, length, sort->elementSize, sort->comparator);
+    }
+    memcpy(elementAt(sort->items, start, sort->elementSize), items, (size_t) length * sort->elementSize);
+}
+
+void parallelSort(void *items, uint32_t size, uint32_t elementSize, ParallelComparator comparator, ThreadPool pool) {
+    if (items == NULL || comparator == NULL) return;
+    uint32_t threadCount = getThreadPoolSize(pool);
+    if (size < PARALLEL_SORT_MIN_SIZE || threadCount < 2) {
+        qsort(items, size, elementSize, comparator);
+        return;
+    }
+
+    uint32_t bucketCount = threadCount * SAMPLE_SORT_BUCKETS_PER_THREAD;
+    if (bucketCount > UINT16_MAX) bucketCount = UINT16_MAX;
+    if (bucketCount > size / SAMPLE_SORT_OVERSAMPLING) bucketCount = size / SAMPLE_SORT_OVERSAMPLING;
+    SampleSort sort = {
+            .items = items,
+            .size = size,
+            .elementSize = elementSize,
+            .comparator = comparator,
+            .bucketCount = bucketCount,
+            .chunkCount = threadCount,
+            .chunkLength = size / threadCount,
+            .buffer = malloc((size_t) size * elementSize),
+            .splitters = malloc((size_t) bucketCount * SAMPLE_SORT_OVERSAMPLING * elementSize),
+            .bucketOf = malloc(sizeof(uint16_t) * size),
+            .offsets = calloc((size_t) threadCount * bucketCount, sizeof(uint32_t)),
+            .bucketStarts = malloc(sizeof(uint32_t) * (bucketCount + 1))
+    };
+    SampleSortTask *tasks = malloc(sizeof(SampleSortTask) * (bucketCount > threadCount ? bucketCount : threadCount));
+    if (sort.buffer == NULL || sort.splitters == NULL || sort.bucketOf == NULL || sort.offsets == NULL ||
+        sort.bucketStarts == NULL || tasks == NULL) {
+        qsort(items, size, elementSize, comparator);
+    } else {
+        chooseSplitters(&sort);
+        for (uint32_t i = 0; i < bucketCount || i < threadCount; i++) {
+            tasks[i] = (SampleSortTask) {.sort = &sort, .index = i};
+        }
+        runPhase(pool, classifyChunk, tasks, sizeof(SampleSortTask), sort.chunkCount);
+
+        uint32_t position = 0;
+        for (uint32_t bucket = 0; bucket < bucketCount; bucket++) {     // chunks write buckets in input order
+            sort.bucketStarts[bucket] = position;
+            for (uint32_t chunk = 0; chunk < sort.chunkCount; chunk++) {
+                uint32_t *offset = &sort.offsets[(size_t) chunk * bucketCount + bucket];
+                uint32_t count = *offset;
+                *offset = position;
+                position += count;
+            }
+        }
+        sort.bucketStarts[bucketCount] = size;
+        runPhase(pool, scatterChunk, tasks, sizeof(SampleSortTask), sort.chunkCount);
+        runPhase(pool, sortBucket, tasks, sizeof(SampleSortTask), bucketCount);
+    }
+    free(sort.buffer);
+    free(sort.splitters);
+    free(sort.bucketOf);
+    free(sort.offsets);
+    free(sort.bucketStarts);
+    free(tasks);
+}
+
+#define RADIX_DIGITS 256
+#define RADIX_COMBINE_BYTES 64      // software write-combining buffer per digit, one cache line
+
+typedef struct RadixSort {
+    uint8_t *source;
+    uint8_t *dest;
+    uint32_t size;
+    uint32_t shift;
+    uint64_t signFlip;          // maps signed keys to unsigned order
+    uint32_t chunkCount;
+    uint32_t chunkLength;
+    uint32_t (*offsets)[RADIX_DIGITS];  // digit histogram of every chunk, then its write positions
+} RadixSort;
+
+typedef struct RadixSortTask {
+    RadixSort *sort;
+    uint32_t index;
+} RadixSortTask;
+
+#define RADIX_SORT_FUNCTIONS(BITS)                                                          \
+static void radixHistogram ##BITS(void *context) {                                          \
+    RadixSortTask *task = context;                                                          \
+    RadixSort *sort = task->sort;                                                           \
+    const uint ##BITS ##_t *items = (const uint ##BITS ##_t *) sort->source;                \
+    uint32_t *counts = sort->offsets[task->index];                                          \
+    uint32_t from = task->index * sort->chunkLength;                                        \
+    uint32_t to = (task->index + 1 == sort->chunkCount) ? sort->size : from + sort->chunkLength;  \
+    memset(counts, 0, sizeof(uint32_t) * RADIX_DIGITS);                                     \
+    for (uint32_t i = from; i < to; i++) {                                                  \
+        counts[((items[i] ^ sort->signFlip) >> sort->shift) & 0xFF]++;                      \
+    }                                                                                       \
+}                                                                                           \
+                                                                                            \
+static void radixScatter ##BITS(void *context) {                                            \
+    RadixSortTask *task = context;                                                          \
+    RadixSort *sort = task->sort;                                                           \
+    const uint ##BITS ##_t *items = (const uint ##BITS ##_t *) sort->source;                \
+    uint ##BITS ##_t *dest = (uint ##BITS ##_t *) sort->dest;                               \
+    uint32_t *offsets = sort->offsets[task->index];                                         \
+    uint32_t from = task->index * sort->chunkLength;                                        \
+    uint32_t to = (task->index + 1 == sort->chunkCount) ? sort->size : from + sort->chunkLength;  \
+    enum { LINE_LENGTH = RADIX_COMBINE_BYTES / sizeof(uint ##BITS ##_t) };                  \
+    uint ##BITS ##_t lines[RADIX_DIGITS][LINE_LENGTH];                                      \
+    uint8_t fill[RADIX_DIGITS] = {0};                                                       \
+    for (uint32_t i = from; i < to; i++) {  /* full lines are flushed with one copy instead of scattered stores */  \
+        uint32_t digit = ((items[i] ^ sort->signFlip) >> sort->shift) & 0xFF;               \
+        lines[digit][fill[digit]++] = items[i];                                             \
+        if (fill[digit] == LINE_LENGTH) {                                                   \
+            memcpy(dest + offsets[digit], lines[digit], RADIX_COMBINE_BYTES);               \
+            offsets[digit] += LINE_LENGTH;                                                  \
+            fill[digit] = 0;                                                                \
+        }                                                                                   \
+    }                                                                                       \
+    for (uint32_t digit = 0; digit < RADIX_DIGITS; digit++) {                               \
+        memcpy(dest + offsets[digit], lines[digit], sizeof(uint ##BITS ##_t) * fill[digit]); \
+    }                                                                                       \
+}
+
+RADIX_SORT_FUNCTIONS(32)
+RADIX_SORT_FUNCTIONS(64)
+
+bool parallelRadixSort(void *items, uint32_t size, VectorElementKind kind, ThreadPool pool) {
+    bool isWide = kind == VECTOR_ELEMENT_I64 || kind == VECTOR_ELEMENT_U64;
+    if (items == NULL || (!isWide && kind != VECTOR_ELEMENT_I32 && kind != VECTOR_ELEMENT_U32)) return false;
+    uint32_t elementSize = isWide ? sizeof(uint64_t) : sizeof(uint32_t);
+    uint32_t threadCount = getThreadPoolSize(pool);
+    if (threadCount > size / RADIX_DIGITS + 1) threadCount = size / RADIX_DIGITS + 1;    // chunks too small for own histogram
+
+    RadixSort sort = {
+            .source = items,
+            .dest = malloc((size_t) size * elementSize),
+            .size = size,
+            .chunkCount = threadCount,
+            .chunkLength = size / threadCount,
+            .offsets = malloc(sizeof(uint32_t) * RADIX_DIGITS * threadCount)
+    };
+    RadixSortTask *tasks = malloc(sizeof(RadixSortTask) * threadCount);
+    if (sort.dest == NULL || sort.offsets == NULL || tasks == NULL) {
+        free(sort.dest);
+        free(sort.offsets);
+        free(tasks);
+        return false;
+    }
+    for (uint32_t i = 0; i < threadCount; i++) {
+        tasks[i] = (RadixSortTask) {.sort = &sort, .index = i};
+    }
+
+    uint8_t *buffer = sort.dest;
+    uint32_t bits = elementSize * 8;
+    bool isSigned = kind == VECTOR_ELEMENT_I32 || kind == VECTOR_ELEMENT_I64;
+    for (sort.shift = 0; sort.shift < bits; sort.shift += 8) {   // LSD passes, each one is stable
+        sort.signFlip = (isSigned && sort.shift + 8 == bits) ? (uint64_t) 1 << (bits - 1) : 0;
+        runPhase(pool, isWide ? radixHistogram64 : radixHistogram32, tasks, sizeof(RadixSortTask), threadCount);
+
+        uint32_t position = 0;
+        bool isSkipped = false;
+        for (uint32_t digit = 0; digit < RADIX_DIGITS; digit++) {   // chunks write each digit in input order
+            uint32_t start = position;
+            for (uint32_t chunk = 0; chunk < threadCount; chunk++) {
+                uint32_t count = sort.offsets[chunk][digit];
+                sort.offsets[chunk][digit] = position;
+                position += count;
+            }
+            isSkipped |= position - start == size;  // every key has this digit
+        }
+        if (isSkipped) continue;
+        runPhase(pool, isWide ? radixScatter64 : radixScatter32, tasks, sizeof(RadixSortTask), threadCount);
+        uint8_t *tmp = sort.source;
+        sort.source = sort.dest;
+        sort.dest = tmp;
+    }
+    if (sort.source != items) {
+        memcpy(items, sort.source, (size_t) size * elementSize);
+    }
+    free(buffer);
+    free(sort.offsets);
+    free(tasks);
+    return true;
+}
+
+typedef struct ParallelLoop {
+    uint8_t *items;
+    uint8_t *results;
+    uint32_t elementSize;
+    uint32_t resultSize;
+    ParallelItemFunction forEach;
+    ParallelMapFunction map;
+    const ParallelReducer *reducer;
+    const uint8_t *identity;
+    uint32_t size;
+    uint32_t chunkLength;
+    void *context;
+} ParallelLoop;
+
+static inline uint32_t cacheChunkLength(uint32_t elementSize) {
+    uint32_t length = PARALLEL_CHUNK_BYTES / elementSize;
+    return (length > 0) ? length : 1;
+}
+
+static void forEachRange(uint32_t begin, uint32_t end, void *context) {
+    ParallelLoop *loop = context;
+    for (uint32_t i = begin; i < end; i++) {
+        loop->forEach(elementAt(loop->items, i, loop->elementSize), loop->context);
+    }
+}
+
+static void mapRange(uint32_t begin, uint32_t end, void *context) {
+    ParallelLoop *loop = context;
+    for (uint32_t i = begin; i < end; i++) {
+        loop->map(elementAt(loop->items, i, loop->elementSize), elementAt(loop->results, i, loop->resultSize), loop->context);
+    }
+}
+
+static void reduceChunks(uint32_t begin, uint32_t end, void *context) {    // one partial result per chunk
+    ParallelLoop *loop = context;
+    for (uint32_t chunk = begin; chunk < end; chunk++) {
+        uint8_t *partial = elementAt(loop->results, chunk, loop->resultSize);
+        uint32_t from = chunk * loop->chunkLength;
+        uint32_t to = (loop->size - from > loop->chunkLength) ? from + loop->chunkLength : loop->size;
+        memcpy(partial, loop->identity, loop->resultSize);
+        for (uint32_t i = from; i < to; i++) {
+            loop->reducer->accumulate(partial, elementAt(loop->items, i, loop->elementSize), loop->reducer->context);
+        }
+    }
+}
+
+void parallelForEach(void *items, uint32_t size, uint32_t elementSize, ParallelItemFunction function, void *context, ThreadPool pool) {
+    if (items == NULL || function == NULL || elementSize == 0) return;
+    ParallelLoop loop = {.items = items, .elementSize = elementSize, .forEach = function, .context = context};
+    parallelFor(pool, 0, size, cacheChunkLength(elementSize), forEachRange, &loop);
+}
+
+void parallelMap(const void *items, void *results, uint32_t size, uint32_t elementSize, uint32_t resultSize,
+                 ParallelMapFunction function, void *context, ThreadPool pool) {
+    if (items == NULL || results == NULL || function == NULL || elementSize == 0) return;
+    ParallelLoop loop = {
+            .items = (uint8_t *) items,
+            .results = results,
+            .elementSize = elementSize,
+            .resultSize = resultSize,
+            .map = function,
+            .context = context
+    };
+    parallelFor(pool, 0, size, cacheChunkLength(elementSize > resultSize ? elementSize : resultSize), mapRange, &loop);
+}
+
+bool parallelReduce(const void *items, uint32_t size, uint32_t elementSize, const ParallelReducer *reducer, void *result, ThreadPool pool) {
+    if (items == NULL || reducer == NULL || result == NULL || elementSize == 0 || reducer->resultSize == 0) return false;
+    uint32_t chunkLength = cacheChunkLength(elementSize);
+    if (!reducer->isDeterministic) {    // fewer and bigger chunks, just enough to balance threads
+        uint32_t chunkCount = getThreadPoolSize(pool) * PARALLEL_REDUCE_CHUNKS_PER_THREAD;
+        uint32_t length = size / chunkCount + (size % chunkCount != 0);
+        if (length > chunkLength) chunkLength = length;
+    }
+    uint32_t chunkCount = size / chunkLength + (size % chunkLength != 0);
+    if (chunkCount == 0) return true;
+
+    ParallelLoop loop = {
+            .items = (uint8_t *) items,
+            .results = malloc((size_t) chunkCount * reducer->resultSize),
+            .elementSize = elementSize,
+            .resultSize = reducer->resultSize,
+            .reducer = reducer,
+            .identity = result,     // combined only after every chunk is accumulated
+            .size = size,
+            .chunkLength = chunkLength
+    };
+    if (loop.results == NULL) return false;
+    parallelFor(pool, 0, chunkCount, 1, reduceChunks, &loop);
+    for (uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+        reducer->combine(result, elementAt(loop.results, chunk, reducer->resultSize), reducer->context);
+    }
+    free(loop.results);
+    return true;
+}
+
+typedef struct ParallelSearch {
+    const void *items;
+    ParallelRangeSearch search;
+    void *context;
+    atomic_uint found;          // lowest matching index seen by any thread, size when nothing is found
+} ParallelSearch;
+
+typedef struct PredicateSearch {
+    uint32_t elementSize;
+    ParallelPredicate predicate;
+    void *context;
+} PredicateSearch;
+
+static void searchRange(uint32_t begin, uint32_t end, void *context) {
+    ParallelSearch *search = context;
+    unsigned int found = atomic_load_explicit(&search->found, memory_order_relaxed);
+    if (begin >= found) return;     // earlier match is already known
+    uint32_t index = search->search(search->items, begin, end, search->context);
+    while (index < end && index < found &&
+           !atomic_compare_exchange_weak_explicit(&search->found, &found, index, memory_order_relaxed, memory_order_relaxed));
+}
+
+static uint32_t searchPredicate(const void *items, uint32_t begin, uint32_t end, void *context) {
+    PredicateSearch *search = context;
+    for (uint32_t i = begin; i < end; i++) {
+        if (search->predicate(elementAt((uint8_t *) items, i, search->elementSize), search->context)) return i;
+    }
+    return end;
+}
+
+int32_t parallelSearch(const void *items, uint32_t size, uint32_t elementSize, ParallelRangeSearch search, void *context, ThreadPool pool) {
+    if (items == NULL || search == NULL || elementSize == 0) return -1;
+    if (size < PARALLEL_SEARCH_MIN_SIZE || getThreadPoolSize(pool) < 2) {
+        uint32_t index = search(items, 0, size, context);
+        return (index < size) ? (int32_t) index : -1;
+    }
+
+    ParallelSearch state = {.items = items, .search = search, .context = context};
+    atomic_init(&state.found, size);
+    parallelFor(pool, 0, size, cacheChunkLength(elementSize), searchRange, &state);
+    uint32_t found = atomic_load(&state.found);
+    return (found < size) ? (int32_t) found : -1;
+}
+
+int32_t parallelFindFirst(const void *items, uint32_t size, uint32_t elementSize, ParallelPredicate predicate, void *context, ThreadPool pool) {
+    if (predicate == NULL) return -1;
+    PredicateSearch search = {.elementSize = elementSize, .predicate = predicate, .context = context};
+    return parallelSearch(items, size, elementSize, searchPredicate, &search, pool);
+}
+
+typedef struct PrefixSum {
+    uint32_t *items;
+    uint32_t size;
+    uint32_t blockLength;
+    uint32_t *offsets;          // sum of every block, then its starting offset
+    bool isExclusive;
+} PrefixSum;
+
+typedef struct MergePath {
+    uint32_t firstSize;
+    uint32_t secondSize;
+    uint32_t segmentCount;
+    MergePathSegment *segments;
+    void *output;
+    uint32_t *counts;           // output length of every segment, then its output position
+    MergePathSplit split;
+    MergePathMerge merge;
+    void *context;
+} MergePath;
+
+typedef struct ParallelCopy {
+    uint8_t *dest;
+    const uint8_t *source;
+    uint32_t elementSize;
+} ParallelCopy;
+
+static void sumBlocks(uint32_t begin, uint32_t end, void *context) {
+    PrefixSum *prefixSum = context;
+    for (uint32_t block = begin; block < end; block++) {
+        uint32_t from = block * prefixSum->blockLength;
+        uint32_t length = (prefixSum->size - from > prefixSum->blockLength) ? prefixSum->blockLength : prefixSum->size - from;
+        prefixSum->offsets[block] = (uint32_t) vectorKernelSum32(prefixSum->items + from, length, false);
+    }
+}
+
+static void scanBlocks(uint32_t begin, uint32_t end, void *context) {
+    PrefixSum *prefixSum = context;
+    for (uint32_t block = begin; block < end; block++) {
+        uint32_t from = block * prefixSum->blockLength;
+        uint32_t length = (prefixSum->size - from > prefixSum->blockLength) ? prefixSum->blockLength : prefixSum->size - from;
+        vectorKernelScan32(prefixSum->items + from, length, prefixSum->isExclusive, prefixSum->offsets[block]);
+    }
+}
+
+static void countSegments(uint32_t begin, uint32_t end, void *context) {
+    MergePath *mergePath = context;
+    uint64_t total = (uint64_t) mergePath->firstSize + mergePath->secondSize;
+    for (uint32_t i = begin; i < end; i++) {
+        MergePathSegment *segment = &mergePath->segments[i];
+        segment->output = mergePath->output;
+        uint32_t from = (uint32_t) (total * i / mergePath->segmentCount);
+        uint32_t to = (uint32_t) (total * (i + 1) / mergePath->segmentCount);
+        mergePath->split(from, &segment->firstFrom, &segment->secondFrom, mergePath->context);
+        if (i + 1 == mergePath->segmentCount) {
+            segment->firstTo = mergePath->firstSize;
+            segment->secondTo = mergePath->secondSize;
+        } else {
+            mergePath->split(to, &segment->firstTo, &segment->secondTo, mergePath->context);
+        }
+        mergePath->counts[i] = mergePath->merge(segment, true, mergePath->context);
+    }
+}
+
+static void writeSegments(uint32_t begin, uint32_t end, void *context) {
+    MergePath *mergePath = context;
+    for (uint32_t i = begin; i < end; i++) {
+        mergePath->segments[i].outputFrom = mergePath->counts[i];
+        mergePath->merge(&mergePath->segments[i], false, mergePath->context);
+    }
+}
+
+static void copyRange(uint32_t begin, uint32_t end, void *context) {
+    ParallelCopy *copy = context;
+    memcpy(copy->dest + (size_t) begin * copy->elementSize, copy->source + (size_t) begin * copy->elementSize,
+           (size_t) (end - begin) * copy->elementSize);
+}
+
+void parallelPrefixSum32(uint32_t *items, uint32_t size, bool isExclusive, ThreadPool pool) {
+    if (items == NULL) return;
+    uint32_t blockLength = cacheChunkLength(sizeof(uint32_t));
+    uint32_t blockCount = size / blockLength + (size % blockLength != 0);
+    PrefixSum prefixSum = {.items = items, .size = size, .blockLength = blockLength, .isExclusive = isExclusive};
+    if (blockCount < 2 || getThreadPoolSize(pool) < 2 || (prefixSum.offsets = malloc(sizeof(uint32_t) * blockCount)) == NULL) {
+        vectorKernelScan32(items, size, isExclusive, 0);
+        return;
+    }
+    parallelFor(pool, 0, blockCount, 1, sumBlocks, &prefixSum);
+    vectorKernelScan32(prefixSum.offsets, blockCount, true, 0);
+    parallelFor(pool, 0, blockCount, 1, scanBlocks, &prefixSum);
+    free(prefixSum.offsets);
+}
+
+bool parallelMergePath(uint32_t firstSize, uint32_t secondSize, void *output, MergePathSplit split, MergePathMerge merge,
+                       void *context, ThreadPool pool, uint32_t *outputSize) {
+    if (split == NULL || merge == NULL || outputSize == NULL) return false;
+    uint64_t total = (uint64_t) firstSize + secondSize;
+    uint64_t segmentCount = (uint64_t) getThreadPoolSize(pool) * MERGE_PATH_SEGMENTS_PER_THREAD;
+    if (segmentCount > total / MERGE_PATH_MIN_SEGMENT + 1) segmentCount = total / MERGE_PATH_MIN_SEGMENT + 1;
+
+    MergePath mergePath = {
+            .firstSize = firstSize,
+            .secondSize = secondSize,
+            .segmentCount = (uint32_t) segmentCount,
+            .segments = malloc(sizeof(MergePathSegment) * segmentCount),
+            .output = output,
+            .counts = malloc(sizeof(uint32_t) * segmentCount),
+            .split = split,
+            .merge = merge,
+            .context = context
+    };
+    if (mergePath.segments == NULL || mergePath.counts == NULL) {
+        free(mergePath.segments);
+        free(mergePath.counts);
+        return false;
+    }
+    parallelFor(pool, 0, mergePath.segmentCount, 1, countSegments, &mergePath);
+    uint32_t lastCount = mergePath.counts[mergePath.segmentCount - 1];
+    vectorKernelScan32(mergePath.counts, mergePath.segmentCount, true, 0);     // few counts per thread, no parallel scan needed
+    parallelFor(pool, 0, mergePath.segmentCount, 1, writeSegments, &mergePath);
+    *outputSize = mergePath.counts[mergePath.segmentCount - 1] + lastCount;
+    free(mergePath.segments);
+    free(mergePath.counts);
+    return true;
+}
+
+bool parallelMergeIntoFirst(void *first, uint32_t firstSize, uint32_t secondSize, uint32_t elementSize, uint32_t capacity,
+                            MergePathSplit split, MergePathMerge merge, void *context, ThreadPool pool, uint32_t *outputSize) {
+    if (first == NULL || elementSize == 0 || outputSize == NULL) return false;
+    void *scratch = malloc((size_t) elementSize * (capacity > 0 ? capacity : 1));  // segments read input while others write
+    if (scratch == NULL || !parallelMergePath(firstSize, secondSize, scratch, split, merge, context, pool, outputSize)) {
+        free(scratch);
+        return false;
+    }
+    parallelCopy(first, scratch, *outputSize, elementSize, pool);
+    free(scratch);
+    return true;
+}
+
+void parallelCopy(void *dest, const void *source, uint32_t size, uint32_t elementSize, ThreadPool pool) {
+    if (dest == NULL || source == NULL || elementSize == 0) return;
+    ParallelCopy copy = {.dest = dest, .source = source, .elementSize = elementSize};
+    parallelFor(pool, 0, size, cacheChunkLength(elementSize) * 8, copyRange, &copy);
+}
+
+static void chooseSplitters(SampleSort *sort) {     // sorted sample is compacted to every OVERSAMPLING-th element
+    uint32_t sampleCount = sort->bucketCount * SAMPLE_SORT_OVERSAMPLING;
+    uint32_t stride = sort->size / sampleCount;
+    uint32_t seed = 2463534242u;
+    for (uint32_t i = 0; i < sampleCount; i++) {
+        seed ^= seed << 13;     // xorshift jitter inside stride, so periodic input doesn't skew sample
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        uint32_t index = i * stride + seed % stride;
+        memcpy(elementAt(sort->splitters, i, sort->elementSize), elementAt(sort->items, index, sort->elementSize), sort->elementSize);
+    }
+    qsort(sort->splitters, sampleCount, sort->elementSize, sort->comparator);
+    for (uint32_t i = 1; i < sort->bucketCount; i++) {
+        memmove(elementAt(sort->splitters, i - 1, sort->elementSize),
+                elementAt(sort->splitters, i * SAMPLE_SORT_OVERSAMPLING, sort->elementSize), sort->elementSize);
+    }
+}
+
+static uint32_t classify(SampleSort *sort, const uint8_t *item) {
+    uint32_t low = 0;
+    uint32_t high = sort->bucketCount - 1;
+    while (low < high) {    // first splitter greater than item
+        uint32_t middle = low + (high - low) / 2;
+        if (sort->comparator(elementAt(sort->splitters, middle, sort->elementSize), item) <= 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low >= 2 && sort->comparator(elementAt(sort->splitters, low - 2, sort->elementSize), item) == 0) {
+        return low - 1;     // repeated splitter value gets own bucket that needs no sorting
+    }
+    return low;
+}
+
+typedef struct ParallelPhase {
+    ThreadPoolTask task;
+    uint8_t *tasks;
+    size_t taskSize;
+} ParallelPhase;
+
+static void runPhaseRange(uint32_t begin, uint32_t end, void *context) {
+    ParallelPhase *phase = context;
+    for (uint32_t i = begin; i < end; i++) {
+        phase->task(phase->tasks + phase->taskSize * i);
+    }
+}
+
+static void runPhase(ThreadPool pool, ThreadPoolTask task, void *tasks, size_t taskSize, uint32_t count) {
+    ParallelPhase phase = {.task = task, .tasks = tasks, .taskSize = taskSize};
+    parallelFor(pool, 0, count, 1, runPhaseRange, &phase);
+}
@@ -2,9 +2,34 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "Comparator.h"
+#include "VectorKernels.h"
+#include "VectorParallel.h"
+
+#ifndef VECTOR_MAX_MERGE_WAYS
+#define VECTOR_MAX_MERGE_WAYS 32    // max vector count for <type>VecIntersectMany() and <type>VecUnionMany()
+#endif
+
+#define VECTOR_MIN_GALLOP 7         // merge switches to block copies after this many wins of one run in a row
+#define VECTOR_MAX_RUN_STACK 64     // pending runs of <type>VecStableSort(), enough for any uint32_t size
+
+#ifndef VECTOR_MAX_QUANTILES
+#define VECTOR_MAX_QUANTILES 64     // max quantile count for single <type>VecQuantiles() call
+#endif
+
+typedef enum VectorIteratorType {   // lazy set operation over two sorted iterators
+    VECTOR_ITERATOR_SOURCE = 0,     // iterates over distinct values of sorted vector
+    VECTOR_ITERATOR_UNION,
+    VECTOR_ITERATOR_INTERSECT,
+    VECTOR_ITERATOR_SUBTRACT,
+    VECTOR_ITERATOR_DISJUNCTION
+} VectorIteratorType;
 
 #define VECTOR_TYPEDEF(NAME) NAME ##Vector
+#define VECTOR_ITERATOR_TYPEDEF(NAME) NAME ##VectorIterator
+#define VECTOR_PREDICATE_TYPEDEF(NAME) NAME ##VectorPredicate
+#define VECTOR_KEY_TYPEDEF(NAME) NAME ##VectorKey
 #define VECTOR_METHOD_NAME_2(PREFIX, NAME, POSTFIX) PREFIX ## NAME ## Vec ## POSTFIX
 #define VECTOR_METHOD_NAME_1(NAME, POSTFIX) NAME ## Vec ## POSTFIX
 
@@ -16,19 +41,33 @@
                         ERROR)(__VA_ARGS__)                    \
 
 
-#define CREATE_VECTOR_TYPE_NAME(TYPE, NAME, COMPARE_FUN) \
+#define CREATE_VECTOR_TYPE_KIND(TYPE, NAME, COMPARE_FUN, KIND) \
 typedef struct VECTOR_TYPEDEF(NAME) {  \
     TYPE *items;                       \
     uint32_t size;                     \
     uint32_t capacity;                 \
 } VECTOR_TYPEDEF(NAME);                \
 \
+static inline VectorElementKind NAME ##_kind(void) {   \
+    return KIND;                       \
+}                                      \
+\
 static inline int NAME ##_compare(const void *a, const void *b) {      \
     TYPE valueA = *((TYPE *) a);                        \
     TYPE valueB = *((TYPE *) b);                        \
     return COMPARE_FUN(valueA, valueB);                 \
 }                                     \
 \
+static bool NAME ##_counting(VECTOR_TYPEDEF(NAME) *vector, VECTOR_TYPEDEF(NAME) *source, VectorCountingOperation operation) {   \
+    if (!VECTOR_IS_COUNTING_KIND(NAME ##_kind())) return false;     /* only 8 and 16-bit integers, no comparator calls */  \
+    if (vector->size + (source != NULL ? source->size : 0) <= VECTOR_INSERTION_SORT_MAX) return false;  \
+    uint32_t size = vectorKernelCountingOperation(vector->items, vector->size, source != NULL ? source->items : NULL,  \
+                                                  source != NULL ? source->size : 0, NAME ##_kind(), operation);  \
+    if (size == VECTOR_KERNEL_NO_MEMORY || size == VECTOR_KERNEL_RANGE_TOO_WIDE) return false;  /* generic code instead */  \
+    vector->size = size;                                            \
+    return true;                                                    \
+}                                     \
+\
 static VECTOR_TYPEDEF(NAME) * new ## NAME ## BuffVector(VECTOR_TYPEDEF(NAME) *vector, TYPE *buffer, uint32_t capacity) { \
     if (vector == NULL || capacity == 0) return NULL;       \
     vector->size = 0;                                       \
@@ -71,13 +110,11 @@ static bool VECTOR_METHOD(NAME, Put)(VECTOR_TYPEDEF(NAME) *vector, uint32_t inde
 }                                      \
 \
 static bool VECTOR_METHOD(NAME, AddAt)(VECTOR_TYPEDEF(NAME) *vector, uint32_t index, TYPE item) { \
-    if (vector != NULL && index < vector->capacity) {               \
+    if (vector != NULL && index <= vector->size) {                  \
         if ((vector->size + 1) > vector->capacity) {                \
             return false;                                           \
         }                                                           \
-        for (uint32_t i = vector->size; i > index; i--) {           \
-            vector->items[i] = vector->items[i - 1];                \
-        }                                                           \
+        memmove(vector->items + index + 1, vector->items + index, sizeof(TYPE) * (vector->size - index));  \
         vector->items[index] = item;                                \
         vector->size++;                                             \
         return true;                                                \
@@ -86,11 +123,9 @@ static bool VECTOR_METHOD(NAME, AddAt)(VECTOR_TYPEDEF(NAME) *vector, uint32_t in
 }                                      \
 \
 static TYPE VECTOR_METHOD(NAME, RemoveAt)(VECTOR_TYPEDEF(NAME) *vector, uint32_t index) {    \
-    if (vector != NULL && index < vector->capacity) {                       \
+    if (vector != NULL && index < vector->size) {                           \
         TYPE item = vector->items[index];                                   \
-        for (uint32_t i = index + 1; i < vector->size; i++) {               \
-            vector->items[i - 1] = vector->items[i];                        \
-        }                                                                   \
+        memmove(vector->items + index, vector->items + index + 1, sizeof(TYPE) * (vector->size - index - 1));  \
         vector->size--;                                                     \
         return item;                                                        \
     }                                                                       \
@@ -111,30 +146,33 @@ static uint32_t VECTOR_METHOD(NAME, Size)(VECTOR_TYPEDEF(NAME) *vector) { \
 \
 static void VECTOR_METHOD(NAME, Clear)(VECTOR_TYPEDEF(NAME) *vector) {   \
     if (vector != NULL) {                               \
-        for (uint32_t i = 0; i < vector->size; i++) {   \
-            vector->items[i] = (TYPE) {0};              \
-        }                                               \
+        memset(vector->items, 0, sizeof(TYPE) * vector->size);  \
+        vector->size = 0;                               \
+    }                                                   \
+}                                      \
+\
+static void VECTOR_METHOD(NAME, Reset)(VECTOR_TYPEDEF(NAME) *vector) {   /* same as Clear(), but buffer is not zeroed */  \
+    if (vector != NULL) {                               \
         vector->size = 0;                               \
     }                                                   \
 }                                      \
 \
 static bool VECTOR_METHOD(NAME, AddAll)(VECTOR_TYPEDEF(NAME) *vecDest, VECTOR_TYPEDEF(NAME) *vecSource) { \
     if (vecDest == NULL || vecSource == NULL) return false; \
-    for (uint32_t i = 0; i < vecSource->size; i++) {        \
-        TYPE item = VECTOR_METHOD(NAME, Get)(vecSource, i);        \
-        if (!VECTOR_METHOD(NAME, Add)(vecDest, item)) {            \
-            return false;                                   \
-        }                                                   \
-    }                                                       \
+    if (vecSource->size > vecDest->capacity - vecDest->size) return false;  /* nothing is added when not all items fit */  \
+    memcpy(vecDest->items + vecDest->size, vecSource->items, sizeof(TYPE) * vecSource->size);  \
+    vecDest->size += vecSource->size;                       \
     return true;                                            \
 }                                           \
 \
 static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, FromArray)(VECTOR_TYPEDEF(NAME) *vector, TYPE array[], uint32_t length) {  \
-    for (uint32_t i = 0; i < length; i++) {             \
-        if (!VECTOR_METHOD(NAME, Add)(vector, array[i])) {     \
-            return vector;                              \
-        }                                               \
+    if (vector == NULL || array == NULL) return vector; \
+    uint32_t count = vector->capacity - vector->size;   \
+    if (length < count) {                               \
+        count = length;                                 \
     }                                                   \
+    memcpy(vector->items + vector->size, array, sizeof(TYPE) * count);  \
+    vector->size += count;                              \
     return vector;                                      \
 }                                           \
 \
@@ -165,8 +203,42 @@ static void VECTOR_METHOD(NAME, Reverse)(VECTOR_TYPEDEF(NAME) *vector) {   \
     }                                               \
 }                                                   \
 \
+static void NAME ##_sortItems(TYPE *items, uint32_t size) {    /* small arrays skip qsort setup and indirect calls */  \
+    if (size > VECTOR_INSERTION_SORT_MAX) {                         \
+        qsort(items, size, sizeof(TYPE), NAME ##_compare);          \
+        return;                                                     \
+    }                                                               \
+    VectorElementKind kind = NAME ##_kind();                        \
+    if ((kind == VECTOR_ELEMENT_I32 || kind == VECTOR_ELEMENT_U32 || kind == VECTOR_ELEMENT_F32) &&   \
+        vectorKernelSortSmall32(items, size, kind)) {               \
+        return;                                                     \
+    }                                                               \
+    uint32_t pairCount;                                             \
+    const uint8_t *pairs = vectorSortNetwork(size, &pairCount);     \
+    if (pairs != NULL) {                                            \
+        for (uint32_t p = 0; p < pairCount; p++, pairs += 2) {      \
+            TYPE one = items[pairs[0]];                             \
+            TYPE two = items[pairs[1]];                             \
+            bool isSwapped = COMPARE_FUN(one, two) > 0;             \
+            items[pairs[0]] = isSwapped ? two : one;                \
+            items[pairs[1]] = isSwapped ? one : two;                \
+        }                                                           \
+        return;                                                     \
+    }                                                               \
+    for (uint32_t i = 1; i < size; i++) {   /* branchless insertion: new item sinks by selects, sorted prefix never swaps */  \
+        for (uint32_t j = i; j > 0; j--) {                          \
+            TYPE one = items[j - 1];                                \
+            TYPE two = items[j];                                    \
+            bool isSwapped = COMPARE_FUN(one, two) > 0;             \
+            items[j - 1] = isSwapped ? two : one;                   \
+            items[j] = isSwapped ? one : two;                       \
+        }                                                           \
+    }                                                               \
+}                                                        \
+\
 static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, Sort)(VECTOR_TYPEDEF(NAME) *vector) {   \
-    qsort(vector->items, vector->size, sizeof(TYPE), NAME ##_compare);      \
+    if (NAME ##_counting(vector, NULL, VECTOR_COUNTING_SORT)) return vector;   \
+    NAME ##_sortItems(vector->items, vector->size);         \
     return vector;   \
 }                                                        \
 \
@@ -188,7 +260,8 @@ static bool VECTOR_METHOD(is, NAME, Equals)(VECTOR_TYPEDEF(NAME) *first, VECTOR_
 \
 static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, RemoveDup)(VECTOR_TYPEDEF(NAME) *vector) {   \
     if (vector == NULL) return NULL;    \
-    qsort(vector->items, vector->size, sizeof(TYPE), NAME ##_compare);   \
+    if (NAME ##_counting(vector, NULL, VECTOR_COUNTING_UNIQUE)) return vector;   \
+    NAME ##_sortItems(vector->items, vector->size);         \
     uint32_t j = 0;                                      \
     for (uint32_t i = 0; i < vector->size; i++) {        \
         if (i == 0) {                                    \
@@ -216,8 +289,9 @@ static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, Union)(VECTOR_TYPEDEF(NAME) *d
 \
 static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, Intersect)(VECTOR_TYPEDEF(NAME) *destVector, VECTOR_TYPEDEF(NAME) *sourceVector) {   \
     if (destVector == NULL || sourceVector == NULL) return NULL;                    \
-    qsort(destVector->items, destVector->size, sizeof(TYPE), NAME ##_compare);      \
-    qsort(sourceVector->items, sourceVector->size, sizeof(TYPE), NAME ##_compare);  \
+    if (NAME ##_counting(destVector, sourceVector, VECTOR_COUNTING_INTERSECT)) return destVector;   \
+    NAME ##_sortItems(destVector->items, destVector->size);                         \
+    NAME ##_sortItems(sourceVector->items, sourceVector->size);                     \
     uint32_t index = 0;                                                             \
     for (uint32_t i = 0, j = 0; i < destVector->size && j < sourceVector->size;) {  \
         TYPE destValue = destVector->items[i];                          \
@@ -241,8 +315,9 @@ static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, Intersect)(VECTOR_TYPEDEF(NAME
 \
 static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, Subtract)(VECTOR_TYPEDEF(NAME) *destVector, VECTOR_TYPEDEF(NAME) *sourceVector) {   \
     if (destVector == NULL || sourceVector == NULL) return NULL;            \
-    qsort(destVector->items, destVector->size, sizeof(TYPE), NAME ##_compare);      \
-    qsort(sourceVector->items, sourceVector->size, sizeof(TYPE), NAME ##_compare);  \
+    if (NAME ##_counting(destVector, sourceVector, VECTOR_COUNTING_SUBTRACT)) return destVector;   \
+    NAME ##_sortItems(destVector->items, destVector->size);                         \
+    NAME ##_sortItems(sourceVector->items, sourceVector->size);                     \
     uint32_t i = 0;         \
     uint32_t j = 0;         \
                             \
@@ -274,7 +349,8 @@ static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, Subtract)(VECTOR_TYPEDEF(NAME)
                                                          \
 static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, Disjunction)(VECTOR_TYPEDEF(NAME) *destVector, VECTOR_TYPEDEF(NAME) *sourceVector) {    \
     if (VECTOR_METHOD(NAME, AddAll)(destVector, sourceVector)) {                           \
-        qsort(destVector->items, destVector->size, sizeof(TYPE), NAME ##_compare);   \
+        if (NAME ##_counting(destVector, NULL, VECTOR_COUNTING_SINGLE)) return destVector;   \
+        NAME ##_sortItems(destVector->items, destVector->size);                     \
         uint32_t index = 0;                                                         \
         for (uint32_t i = 0, j = 1; j <= destVector->size; j++) {                   \
             if (i == destVector->size - 1) {                                        \
@@ -298,10 +374,1064 @@ static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, Disjunction)(VECTOR_TYPEDEF(NA
     return NULL;                                                                    \
 }                                                        \
 \
+static bool NAME ##_ensureSorted(VECTOR_TYPEDEF(NAME) *vector) {     /* returns true when vector has no duplicates */ \
+    bool isUnique = true;                                           \
+    bool isSortCalled = false;                                      \
+    for (uint32_t i = 1; i < vector->size; i++) {                   \
+        int result = COMPARE_FUN(vector->items[i - 1], vector->items[i]);  \
+        if (result > 0 && !isSortCalled) {      /* sort and recheck for duplicates */  \
+            VECTOR_METHOD(NAME, Sort)(vector);                      \
+            isSortCalled = true;                                    \
+            isUnique = true;                                        \
+            i = 0;                                                  \
+            continue;                                               \
+        }                                                           \
+        isUnique = isUnique && result != 0;                         \
+    }                                                               \
+    return isUnique;                                                \
+}                                                        \
+\
+static uint32_t NAME ##_gallop(TYPE *items, uint32_t from, uint32_t size, TYPE value) {  \
+    if (from >= size || COMPARE_FUN(items[from], value) >= 0) return from;  \
+    uint32_t low = from;    /* items[low] < value */                        \
+    uint32_t high = from + 1;                                               \
+    uint32_t step = 1;                                                      \
+    while (high < size && COMPARE_FUN(items[high], value) < 0) {            \
+        low = high;                                                         \
+        step *= 2;                                                          \
+        high = (step < size - from) ? from + step : size;                   \
+    }                                                                       \
+    low++;                                                                  \
+    while (low < high) {                                                    \
+        uint32_t middle = low + (high - low) / 2;                           \
+        if (COMPARE_FUN(items[middle], value) < 0) {                        \
+            low = middle + 1;                                               \
+        } else {                                                            \
+            high = middle;                                                  \
+        }                                                                   \
+    }                                                                       \
+    return low;                                                             \
+}                                                        \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, IntersectMany)(VECTOR_TYPEDEF(NAME) *destVector, VECTOR_TYPEDEF(NAME) *vectors[], uint32_t count) {   \
+    if (destVector == NULL || vectors == NULL || count > VECTOR_MAX_MERGE_WAYS) return NULL;   \
+    uint32_t order[VECTOR_MAX_MERGE_WAYS];                                  \
+    uint32_t cursors[VECTOR_MAX_MERGE_WAYS] = {0};                          \
+    for (uint32_t i = 0; i < count; i++) {                                  \
+        if (vectors[i] == NULL || vectors[i] == destVector) return NULL;    \
+        NAME ##_ensureSorted(vectors[i]);                                   \
+        uint32_t j = i;                 /* keep order sorted by size, smallest first */   \
+        while (j > 0 && vectors[order[j - 1]]->size > vectors[i]->size) {   \
+            order[j] = order[j - 1];                                        \
+            j--;                                                            \
+        }                                                                   \
+        order[j] = i;                                                       \
+    }                                                                       \
+    destVector->size = 0;                                                   \
+    if (count == 0) return destVector;                                      \
+                                                                            \
+    VECTOR_TYPEDEF(NAME) *smallest = vectors[order[0]];                     \
+    for (uint32_t i = 0; i < smallest->size; i++) {                         \
+        TYPE value = smallest->items[i];                                    \
+        if (i > 0 && COMPARE_FUN(smallest->items[i - 1], value) == 0) continue;   \
+                                                                            \
+        bool isCommon = true;                                               \
+        for (uint32_t k = 1; k < count; k++) {                              \
+            VECTOR_TYPEDEF(NAME) *other = vectors[order[k]];                \
+            cursors[k] = NAME ##_gallop(other->items, cursors[k], other->size, value);  \
+            if (cursors[k] == other->size) return destVector;   /* nothing left in common */ \
+            if (COMPARE_FUN(other->items[cursors[k]], value) != 0) {        \
+                isCommon = false;                                           \
+                break;                                                      \
+            }                                                               \
+        }                                                                   \
+        if (isCommon && !VECTOR_METHOD(NAME, Add)(destVector, value)) {     \
+            return destVector;                                              \
+        }                                                                   \
+    }                                                                       \
+    return destVector;                                                      \
+}                                                        \
+\
+static bool NAME ##_mergeBeats(VECTOR_TYPEDEF(NAME) *vectors[], const uint32_t cursors[], uint32_t count, uint32_t one, uint32_t two) {  \
+    if (one == count) return true;      /* initialization sentinel wins over everything */   \
+    if (two == count) return false;                                         \
+    if (cursors[one] >= vectors[one]->size) return false;   /* exhausted input always loses */  \
+    if (cursors[two] >= vectors[two]->size) return true;                    \
+    int result = COMPARE_FUN(vectors[one]->items[cursors[one]], vectors[two]->items[cursors[two]]);  \
+    return result < 0 || (result == 0 && one < two);                        \
+}                                                        \
+\
+static void NAME ##_mergeAdjust(uint32_t tree[], VECTOR_TYPEDEF(NAME) *vectors[], const uint32_t cursors[], uint32_t count, uint32_t leaf) {  \
+    uint32_t winner = leaf;                                                 \
+    for (uint32_t node = (leaf + count) / 2; node > 0; node /= 2) {         \
+        if (NAME ##_mergeBeats(vectors, cursors, count, tree[node], winner)) {  \
+            uint32_t loser = winner;                                        \
+            winner = tree[node];                                            \
+            tree[node] = loser;                                             \
+        }                                                                   \
+    }                                                                       \
+    tree[0] = winner;                                                       \
+}                                                        \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, UnionMany)(VECTOR_TYPEDEF(NAME) *destVector, VECTOR_TYPEDEF(NAME) *vectors[], uint32_t count) {   \
+    if (destVector == NULL || vectors == NULL || count > VECTOR_MAX_MERGE_WAYS) return NULL;   \
+    uint32_t tree[VECTOR_MAX_MERGE_WAYS];      /* loser tree, tree[0] holds the current winner */   \
+    uint32_t cursors[VECTOR_MAX_MERGE_WAYS] = {0};                          \
+    for (uint32_t i = 0; i < count; i++) {                                  \
+        if (vectors[i] == NULL || vectors[i] == destVector) return NULL;    \
+        NAME ##_ensureSorted(vectors[i]);                                   \
+        tree[i] = count;                                                    \
+    }                                                                       \
+    destVector->size = 0;                                                   \
+    if (count == 0) return destVector;                                      \
+                                                                            \
+    for (uint32_t i = count; i > 0; i--) {                                  \
+        NAME ##_mergeAdjust(tree, vectors, cursors, count, i - 1);          \
+    }                                                                       \
+    while (true) {                                                          \
+        uint32_t winner = tree[0];                                          \
+        if (cursors[winner] >= vectors[winner]->size) break;    /* all inputs are exhausted */  \
+        TYPE value = vectors[winner]->items[cursors[winner]++];             \
+        if (destVector->size == 0 || COMPARE_FUN(destVector->items[destVector->size - 1], value) != 0) {  \
+            if (!VECTOR_METHOD(NAME, Add)(destVector, value)) break;        \
+        }                                                                   \
+        NAME ##_mergeAdjust(tree, vectors, cursors, count, winner);         \
+    }                                                                       \
+    return destVector;                                                      \
+}                                                        \
+\
+static uint32_t NAME ##_distinctCount(VECTOR_TYPEDEF(NAME) *vector) {   /* vector must be sorted */   \
+    uint32_t count = vector->size > 0 ? 1 : 0;                              \
+    for (uint32_t i = 1; i < vector->size; i++) {                           \
+        if (COMPARE_FUN(vector->items[i - 1], vector->items[i]) != 0) {     \
+            count++;                                                        \
+        }                                                                   \
+    }                                                                       \
+    return count;                                                           \
+}                                                        \
+\
+/* Sorted inputs are only read. Unsorted input has to be sorted in place, buffer vectors have no memory for sorted copy */  \
+static uint32_t NAME ##_countSets(VECTOR_TYPEDEF(NAME) *first, VECTOR_TYPEDEF(NAME) *second, uint32_t *firstDistinct, uint32_t *secondDistinct) { \
+    bool isFirstUnique = NAME ##_ensureSorted(first);                       \
+    bool isSecondUnique = NAME ##_ensureSorted(second);                     \
+    *firstDistinct = isFirstUnique ? first->size : NAME ##_distinctCount(first);      \
+    *secondDistinct = isSecondUnique ? second->size : NAME ##_distinctCount(second);  \
+    if (isFirstUnique && isSecondUnique && (NAME ##_kind() == VECTOR_ELEMENT_I32 || NAME ##_kind() == VECTOR_ELEMENT_U32)) {  \
+        return vectorKernelIntersectCount32(first->items, first->size, second->items, second->size, NAME ##_kind() == VECTOR_ELEMENT_I32);  \
+    }                                                                       \
+                                                                            \
+    uint32_t count = 0;                                                     \
+    uint32_t i = 0;                                                         \
+    uint32_t j = 0;                                                         \
+    while (i < first->size && j < second->size) {                           \
+        int result = COMPARE_FUN(first->items[i], second->items[j]);        \
+        if (result < 0) {                                                   \
+            i = NAME ##_gallop(first->items, i, first->size, second->items[j]);   \
+        } else if (result > 0) {                                            \
+            j = NAME ##_gallop(second->items, j, second->size, first->items[i]);  \
+        } else {                                                            \
+            TYPE value = first->items[i];                                   \
+            while (i < first->size && COMPARE_FUN(first->items[i], value) == 0) i++;    \
+            while (j < second->size && COMPARE_FUN(second->items[j], value) == 0) j++;  \
+            count++;                                                        \
+        }                                                                   \
+    }                                                                       \
+    return count;                                                           \
+}                                                        \
+\
+static uint32_t VECTOR_METHOD(NAME, IntersectCount)(VECTOR_TYPEDEF(NAME) *first, VECTOR_TYPEDEF(NAME) *second) {   /* sorts unsorted inputs in place */ \
+    if (first == NULL || second == NULL) return 0;                          \
+    uint32_t firstDistinct, secondDistinct;                                 \
+    return NAME ##_countSets(first, second, &firstDistinct, &secondDistinct);   \
+}                                                        \
+\
+static uint32_t VECTOR_METHOD(NAME, UnionCount)(VECTOR_TYPEDEF(NAME) *first, VECTOR_TYPEDEF(NAME) *second) {   /* sorts unsorted inputs in place */ \
+    if (first == NULL || second == NULL) return 0;                          \
+    uint32_t firstDistinct, secondDistinct;                                 \
+    uint32_t common = NAME ##_countSets(first, second, &firstDistinct, &secondDistinct);   \
+    return firstDistinct + secondDistinct - common;                         \
+}                                                        \
+\
+static uint32_t VECTOR_METHOD(NAME, SubtractCount)(VECTOR_TYPEDEF(NAME) *first, VECTOR_TYPEDEF(NAME) *second) {   /* sorts unsorted inputs in place */ \
+    if (first == NULL || second == NULL) return 0;                          \
+    uint32_t firstDistinct, secondDistinct;                                 \
+    uint32_t common = NAME ##_countSets(first, second, &firstDistinct, &secondDistinct);   \
+    return firstDistinct - common;                                          \
+}                                                        \
+\
+static uint32_t VECTOR_METHOD(NAME, DisjunctionCount)(VECTOR_TYPEDEF(NAME) *first, VECTOR_TYPEDEF(NAME) *second) {   /* sorts unsorted inputs in place */ \
+    if (first == NULL || second == NULL) return 0;                          \
+    uint32_t firstDistinct, secondDistinct;                                 \
+    uint32_t common = NAME ##_countSets(first, second, &firstDistinct, &secondDistinct);   \
+    return firstDistinct + secondDistinct - 2 * common;                     \
+}                                                        \
+\
+static double VECTOR_METHOD(NAME, Jaccard)(VECTOR_TYPEDEF(NAME) *first, VECTOR_TYPEDEF(NAME) *second) {   /* sorts unsorted inputs in place */ \
+    if (first == NULL || second == NULL) return 0;                          \
+    uint32_t firstDistinct, secondDistinct;                                 \
+    uint32_t common = NAME ##_countSets(first, second, &firstDistinct, &secondDistinct);   \
+    uint32_t total = firstDistinct + secondDistinct - common;               \
+    return total > 0 ? (double) common / total : 0;                         \
+}                                                        \
+\
+typedef struct VECTOR_ITERATOR_TYPEDEF(NAME) {                              \
+    VectorIteratorType type;                                                \
+    VECTOR_TYPEDEF(NAME) *vector;                                           \
+    uint32_t index;                                                         \
+    struct VECTOR_ITERATOR_TYPEDEF(NAME) *left;                             \
+    struct VECTOR_ITERATOR_TYPEDEF(NAME) *right;                            \
+    TYPE leftValue;                                                         \
+    TYPE rightValue;                                                        \
+    bool hasLeft;                                                           \
+    bool hasRight;                                                          \
+    bool isStarted;                                                         \
+} VECTOR_ITERATOR_TYPEDEF(NAME);                                            \
+\
+static VECTOR_ITERATOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, Iterator)(VECTOR_ITERATOR_TYPEDEF(NAME) *iterator, VECTOR_TYPEDEF(NAME) *vector) {  /* unsorted vector is sorted in place */  \
+    if (iterator == NULL || vector == NULL) return NULL;                    \
+    NAME ##_ensureSorted(vector);                                           \
+    *iterator = (VECTOR_ITERATOR_TYPEDEF(NAME)) {.type = VECTOR_ITERATOR_SOURCE, .vector = vector};  \
+    return iterator;                                                        \
+}                                                        \
+\
+static VECTOR_ITERATOR_TYPEDEF(NAME) * NAME ##_newOperationIterator(VECTOR_ITERATOR_TYPEDEF(NAME) *iterator, VectorIteratorType type,   \
+                                                                     VECTOR_ITERATOR_TYPEDEF(NAME) *left, VECTOR_ITERATOR_TYPEDEF(NAME) *right) {  \
+    if (iterator == NULL || left == NULL || right == NULL) return NULL;     \
+    *iterator = (VECTOR_ITERATOR_TYPEDEF(NAME)) {.type = type, .left = left, .right = right};  \
+    return iterator;                                                        \
+}                                                        \
+\
+static VECTOR_ITERATOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, UnionIterator)(VECTOR_ITERATOR_TYPEDEF(NAME) *iterator,  \
+                                                                           VECTOR_ITERATOR_TYPEDEF(NAME) *left, VECTOR_ITERATOR_TYPEDEF(NAME) *right) {  \
+    return NAME ##_newOperationIterator(iterator, VECTOR_ITERATOR_UNION, left, right);   \
+}                                                        \
+\
+static VECTOR_ITERATOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, IntersectIterator)(VECTOR_ITERATOR_TYPEDEF(NAME) *iterator,  \
+                                                                               VECTOR_ITERATOR_TYPEDEF(NAME) *left, VECTOR_ITERATOR_TYPEDEF(NAME) *right) {  \
+    return NAME ##_newOperationIterator(iterator, VECTOR_ITERATOR_INTERSECT, left, right);   \
+}                                                        \
+\
+static VECTOR_ITERATOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, SubtractIterator)(VECTOR_ITERATOR_TYPEDEF(NAME) *iterator,  \
+                                                                              VECTOR_ITERATOR_TYPEDEF(NAME) *left, VECTOR_ITERATOR_TYPEDEF(NAME) *right) {  \
+    return NAME ##_newOperationIterator(iterator, VECTOR_ITERATOR_SUBTRACT, left, right);   \
+}                                                        \
+\
+static VECTOR_ITERATOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, DisjunctionIterator)(VECTOR_ITERATOR_TYPEDEF(NAME) *iterator,  \
+                                                                                 VECTOR_ITERATOR_TYPEDEF(NAME) *left, VECTOR_ITERATOR_TYPEDEF(NAME) *right) {  \
+    return NAME ##_newOperationIterator(iterator, VECTOR_ITERATOR_DISJUNCTION, left, right);   \
+}                                                        \
+\
+static bool VECTOR_METHOD(NAME, IteratorNext)(VECTOR_ITERATOR_TYPEDEF(NAME) *iterator, TYPE *value) {  \
+    if (iterator == NULL || value == NULL) return false;                    \
+    if (iterator->type == VECTOR_ITERATOR_SOURCE) {                         \
+        while (iterator->index < iterator->vector->size) {                  \
+            TYPE item = iterator->vector->items[iterator->index++];         \
+            if (!iterator->hasLeft || COMPARE_FUN(iterator->leftValue, item) != 0) {   /* skip duplicates */  \
+                iterator->leftValue = item;                                 \
+                iterator->hasLeft = true;                                   \
+                *value = item;                                              \
+                return true;                                                \
+            }                                                               \
+        }                                                                   \
+        return false;                                                       \
+    }                                                                       \
+                                                                            \
+    if (!iterator->isStarted) {                                             \
+        iterator->hasLeft = VECTOR_METHOD(NAME, IteratorNext)(iterator->left, &iterator->leftValue);      \
+        iterator->hasRight = VECTOR_METHOD(NAME, IteratorNext)(iterator->right, &iterator->rightValue);   \
+        iterator->isStarted = true;                                         \
+    }                                                                       \
+    while (iterator->hasLeft || iterator->hasRight) {                       \
+        int result;                                                         \
+        if (!iterator->hasRight) {                                          \
+            result = -1;                                                    \
+        } else if (!iterator->hasLeft) {                                    \
+            result = 1;                                                     \
+        } else {                                                            \
+            result = COMPARE_FUN(iterator->leftValue, iterator->rightValue);\
+        }                                                                   \
+                                                                            \
+        if (iterator->type == VECTOR_ITERATOR_INTERSECT && (!iterator->hasLeft || !iterator->hasRight)) return false;  \
+        if (iterator->type == VECTOR_ITERATOR_SUBTRACT && !iterator->hasLeft) return false;   \
+                                                                            \
+        bool isEmitted = (result < 0 && iterator->type != VECTOR_ITERATOR_INTERSECT) ||       \
+                         (result > 0 && (iterator->type == VECTOR_ITERATOR_UNION || iterator->type == VECTOR_ITERATOR_DISJUNCTION)) ||  \
+                         (result == 0 && (iterator->type == VECTOR_ITERATOR_UNION || iterator->type == VECTOR_ITERATOR_INTERSECT));     \
+        if (isEmitted) {                                                    \
+            *value = result <= 0 ? iterator->leftValue : iterator->rightValue;  \
+        }                                                                   \
+        if (result <= 0) {                                                  \
+            iterator->hasLeft = VECTOR_METHOD(NAME, IteratorNext)(iterator->left, &iterator->leftValue);      \
+        }                                                                   \
+        if (result >= 0) {                                                  \
+            iterator->hasRight = VECTOR_METHOD(NAME, IteratorNext)(iterator->right, &iterator->rightValue);   \
+        }                                                                   \
+        if (isEmitted) return true;                                         \
+    }                                                                       \
+    return false;                                                           \
+}                                                        \
+\
+static uint32_t VECTOR_METHOD(NAME, AddFromIterator)(VECTOR_TYPEDEF(NAME) *vector, VECTOR_ITERATOR_TYPEDEF(NAME) *iterator, uint32_t limit) {  \
+    if (vector == NULL || iterator == NULL) return 0;                       \
+    uint32_t count = 0;                                                     \
+    TYPE value;                                                             \
+    while (count < limit && vector->size < vector->capacity && VECTOR_METHOD(NAME, IteratorNext)(iterator, &value)) {  \
+        vector->items[vector->size++] = value;                              \
+        count++;                                                            \
+    }                                                                       \
+    return count;                                                           \
+}                                                        \
+\
+typedef bool (*VECTOR_PREDICATE_TYPEDEF(NAME))(TYPE item, void *context);  \
+\
+static VECTOR_TYPEDEF(NAME) * NAME ##_compactIf(VECTOR_TYPEDEF(NAME) *vector, VECTOR_PREDICATE_TYPEDEF(NAME) predicate, void *context, bool isRetained) {  \
+    if (vector == NULL || predicate == NULL) return NULL;                   \
+    uint32_t j = 0;                                                         \
+    for (uint32_t i = 0; i < vector->size; i++) {   /* branchless, every item is written */   \
+        TYPE item = vector->items[i];                                       \
+        vector->items[j] = item;                                            \
+        j += predicate(item, context) == isRetained;                        \
+    }                                                                       \
+    vector->size = j;                                                       \
+    return vector;                                                          \
+}                                                        \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, RemoveIf)(VECTOR_TYPEDEF(NAME) *vector, VECTOR_PREDICATE_TYPEDEF(NAME) predicate, void *context) {  \
+    return NAME ##_compactIf(vector, predicate, context, false);            \
+}                                                        \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, RetainIf)(VECTOR_TYPEDEF(NAME) *vector, VECTOR_PREDICATE_TYPEDEF(NAME) predicate, void *context) {  \
+    return NAME ##_compactIf(vector, predicate, context, true);             \
+}                                                        \
+\
+static uint32_t VECTOR_METHOD(NAME, Partition)(VECTOR_TYPEDEF(NAME) *vector, VECTOR_PREDICATE_TYPEDEF(NAME) predicate, void *context) {  \
+    if (vector == NULL || predicate == NULL) return 0;                      \
+    uint32_t low = 0;                                                       \
+    uint32_t high = vector->size;                                           \
+    while (true) {                                                          \
+        while (low < high && predicate(vector->items[low], context)) low++;         \
+        while (low < high && !predicate(vector->items[high - 1], context)) high--;  \
+        if (low >= high) return low;                                        \
+        TYPE tmp = vector->items[low];                                      \
+        vector->items[low++] = vector->items[--high];                       \
+        vector->items[high] = tmp;                                          \
+    }                                                                       \
+}                                                        \
+\
+static void NAME ##_reverseRange(TYPE *items, uint32_t from, uint32_t to) {  /* reverses [from, to) */ \
+    while (from + 1 < to) {                                                 \
+        TYPE tmp = items[from];                                             \
+        items[from++] = items[--to];                                        \
+        items[to] = tmp;                                                    \
+    }                                                                       \
+}                                                        \
+\
+static void NAME ##_rotate(TYPE *items, uint32_t from, uint32_t middle, uint32_t to) {  /* [middle, to) moves before [from, middle) */ \
+    NAME ##_reverseRange(items, from, middle);                              \
+    NAME ##_reverseRange(items, middle, to);                                \
+    NAME ##_reverseRange(items, from, to);                                  \
+}                                                        \
+\
+static uint32_t NAME ##_stablePartition(TYPE *items, uint32_t size, VECTOR_PREDICATE_TYPEDEF(NAME) predicate, void *context) {  \
+    if (size <= 1) {                                                        \
+        return (size == 1 && predicate(items[0], context)) ? 1 : 0;         \
+    }                                                                       \
+    uint32_t half = size / 2;                                               \
+    uint32_t left = NAME ##_stablePartition(items, half, predicate, context);                       \
+    uint32_t right = NAME ##_stablePartition(items + half, size - half, predicate, context);        \
+    NAME ##_rotate(items, left, half, half + right);                        \
+    return left + right;                                                    \
+}                                                        \
+\
+static uint32_t VECTOR_METHOD(NAME, StablePartition)(VECTOR_TYPEDEF(NAME) *vector, VECTOR_PREDICATE_TYPEDEF(NAME) predicate, void *context,  \
+                                                     TYPE *scratch, uint32_t scratchLength) {  \
+    if (vector == NULL || predicate == NULL) return 0;                      \
+    if (scratch == NULL || scratchLength < vector->size) {      /* in place, O(n log n) moves */  \
+        return NAME ##_stablePartition(vector->items, vector->size, predicate, context);  \
+    }                                                                       \
+    uint32_t j = 0;                                                         \
+    uint32_t k = 0;                                                         \
+    for (uint32_t i = 0; i < vector->size; i++) {                           \
+        TYPE item = vector->items[i];                                       \
+        if (predicate(item, context)) {                                     \
+            vector->items[j++] = item;                                      \
+        } else {                                                            \
+            scratch[k++] = item;                                            \
+        }                                                                   \
+    }                                                                       \
+    memcpy(vector->items + j, scratch, sizeof(TYPE) * k);                   \
+    return j;                                                               \
+}                                                        \
+\
+static uint32_t NAME ##_gallopUpper(TYPE *items, uint32_t from, uint32_t size, TYPE value) {   /* first index with item > value */  \
+    if (from >= size || COMPARE_FUN(items[from], value) > 0) return from;  \
+    uint32_t low = from;    /* items[low] <= value */                       \
+    uint32_t high = from + 1;                                               \
+    uint32_t step = 1;                                                      \
+    while (high < size && COMPARE_FUN(items[high], value) <= 0) {           \
+        low = high;                                                         \
+        step *= 2;                                                          \
+        high = (step < size - from) ? from + step : size;                   \
+    }                                                                       \
+    low++;                                                                  \
+    while (low < high) {                                                    \
+        uint32_t middle = low + (high - low) / 2;                           \
+        if (COMPARE_FUN(items[middle], value) <= 0) {                       \
+            low = middle + 1;                                               \
+        } else {                                                            \
+            high = middle;                                                  \
+        }                                                                   \
+    }                                                                       \
+    return low;                                                             \
+}                                                        \
+\
+static void NAME ##_binaryInsertion(TYPE *items, uint32_t from, uint32_t start, uint32_t to) {  /* [from, start) is sorted */  \
+    for (uint32_t i = start; i < to; i++) {                                 \
+        TYPE value = items[i];                                              \
+        uint32_t low = from;                                                \
+        uint32_t high = i;                                                  \
+        while (low < high) {            /* insert after equal items, so order of ties is kept */  \
+            uint32_t middle = low + (high - low) / 2;                       \
+            if (COMPARE_FUN(value, items[middle]) < 0) {                    \
+                high = middle;                                              \
+            } else {                                                        \
+                low = middle + 1;                                           \
+            }                                                               \
+        }                                                                   \
+        memmove(items + low + 1, items + low, sizeof(TYPE) * (i - low));    \
+        items[low] = value;                                                 \
+    }                                                                       \
+}                                                        \
+\
+static uint32_t NAME ##_runEnd(TYPE *items, uint32_t from, uint32_t size) {  /* strictly descending runs are reversed */  \
+    uint32_t end = from + 1;                                                \
+    if (end >= size) return size;                                           \
+    if (COMPARE_FUN(items[end], items[from]) < 0) {                         \
+        while (end + 1 < size && COMPARE_FUN(items[end + 1], items[end]) < 0) end++;  \
+        NAME ##_reverseRange(items, from, end + 1);                         \
+    } else {                                                                \
+        while (end + 1 < size && COMPARE_FUN(items[end + 1], items[end]) >= 0) end++;  \
+    }                                                                       \
+    return end + 1;                                                         \
+}                                                        \
+\
+static void NAME ##_mergeLow(TYPE *items, uint32_t from, uint32_t middle, uint32_t to, TYPE *scratch) {  /* left run goes to scratch */  \
+    uint32_t leftLength = middle - from;                                    \
+    memcpy(scratch, items + from, sizeof(TYPE) * leftLength);               \
+    uint32_t i = 0;                                                         \
+    uint32_t j = middle;                                                    \
+    uint32_t k = from;                                                      \
+    uint32_t leftWins = 0;                                                  \
+    uint32_t rightWins = 0;                                                 \
+    while (i < leftLength && j < to) {                                      \
+        if (COMPARE_FUN(items[j], scratch[i]) < 0) {                        \
+            items[k++] = items[j++];                                        \
+            leftWins = 0;                                                   \
+            if (++rightWins >= VECTOR_MIN_GALLOP) {  /* copy whole block of smaller right items */  \
+                uint32_t end = NAME ##_gallop(items, j, to, scratch[i]);    \
+                memmove(items + k, items + j, sizeof(TYPE) * (end - j));    \
+                k += end - j;                                               \
+                j = end;                                                    \
+                rightWins = 0;                                              \
+            }                                                               \
+        } else {                                                            \
+            items[k++] = scratch[i++];                                      \
+            rightWins = 0;                                                  \
+            if (++leftWins >= VECTOR_MIN_GALLOP) {                          \
+                uint32_t end = NAME ##_gallopUpper(scratch, i, leftLength, items[j]);  \
+                memcpy(items + k, scratch + i, sizeof(TYPE) * (end - i));   \
+                k += end - i;                                               \
+                i = end;                                                    \
+                leftWins = 0;                                               \
+            }                                                               \
+        }                                                                   \
+    }                                                                       \
+    memcpy(items + k, scratch + i, sizeof(TYPE) * (leftLength - i));        \
+}                                                        \
+\
+static void NAME ##_mergeHigh(TYPE *items, uint32_t from, uint32_t middle, uint32_t to, TYPE *scratch) {  /* right run goes to scratch */  \
+    uint32_t rightLength = to - middle;                                     \
+    memcpy(scratch, items + middle, sizeof(TYPE) * rightLength);            \
+    uint32_t i = middle;        /* items[from, i) and scratch[0, j) are not merged yet */  \
+    uint32_t j = rightLength;                                               \
+    uint32_t k = to;                                                        \
+    uint32_t leftWins = 0;                                                  \
+    uint32_t rightWins = 0;                                                 \
+    while (i > from && j > 0) {                                             \
+        if (COMPARE_FUN(scratch[j - 1], items[i - 1]) < 0) {                \
+            items[--k] = items[--i];                                        \
+            rightWins = 0;                                                  \
+            if (++leftWins >= VECTOR_MIN_GALLOP) {   /* copy whole block of greater left items */  \
+                uint32_t start = NAME ##_gallopUpper(items, from, i, scratch[j - 1]);  \
+                k -= i - start;                                             \
+                memmove(items + k, items + start, sizeof(TYPE) * (i - start));  \
+                i = start;                                                  \
+                leftWins = 0;                                               \
+            }                                                               \
+        } else {                                                            \
+            items[--k] = scratch[--j];                                      \
+            leftWins = 0;                                                   \
+            if (++rightWins >= VECTOR_MIN_GALLOP) {                         \
+                uint32_t start = NAME ##_gallop(scratch, 0, j, items[i - 1]);  \
+                k -= j - start;                                             \
+                memcpy(items + k, scratch + start, sizeof(TYPE) * (j - start));  \
+                j = start;                                                  \
+                rightWins = 0;                                              \
+            }                                                               \
+        }                                                                   \
+    }                                                                       \
+    memcpy(items + from, scratch, sizeof(TYPE) * j);                        \
+}                                                        \
+\
+static void NAME ##_mergeInPlace(TYPE *items, uint32_t from, uint32_t middle, uint32_t to) {  /* rotations, O(n log n) moves */  \
+    while (from < middle && middle < to) {                                  \
+        if (to - from == 2) {                                               \
+            if (COMPARE_FUN(items[middle], items[from]) < 0) {              \
+                NAME ##_rotate(items, from, middle, to);                    \
+            }                                                               \
+            return;                                                         \
+        }                                                                   \
+        uint32_t firstCut;                                                  \
+        uint32_t secondCut;                                                 \
+        if (middle - from > to - middle) {                                  \
+            firstCut = from + (middle - from) / 2;                          \
+            secondCut = NAME ##_gallop(items, middle, to, items[firstCut]); \
+        } else {                                                            \
+            secondCut = middle + (to - middle) / 2;                         \
+            firstCut = NAME ##_gallopUpper(items, from, middle, items[secondCut]);  \
+        }                                                                   \
+        NAME ##_rotate(items, firstCut, middle, secondCut);                 \
+        uint32_t newMiddle = firstCut + (secondCut - middle);               \
+        NAME ##_mergeInPlace(items, from, firstCut, newMiddle);             \
+        from = newMiddle;                                                   \
+        middle = secondCut;                                                 \
+    }                                                                       \
+}                                                        \
+\
+static void NAME ##_mergeRuns(TYPE *items, uint32_t from, uint32_t middle, uint32_t to, TYPE *scratch, uint32_t scratchLength) {  \
+    from = NAME ##_gallopUpper(items, from, middle, items[middle]);    /* left items not greater than right start stay */  \
+    to = NAME ##_gallop(items, middle, to, items[middle - 1]);         /* right items not less than left end stay */  \
+    if (from == middle || middle == to) return;                             \
+    if (scratch != NULL && middle - from <= to - middle && middle - from <= scratchLength) {  \
+        NAME ##_mergeLow(items, from, middle, to, scratch);                 \
+    } else if (scratch != NULL && to - middle <= scratchLength) {           \
+        NAME ##_mergeHigh(items, from, middle, to, scratch);                \
+    } else {                                                                \
+        NAME ##_mergeInPlace(items, from, middle, to);                      \
+    }                                                                       \
+}                                                        \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, StableSort)(VECTOR_TYPEDEF(NAME) *vector, TYPE *scratch, uint32_t scratchLength) {  \
+    if (vector == NULL) return NULL;    /* scratch is optional, half of vector size is enough to never merge in place */  \
+    TYPE *items = vector->items;                                            \
+    uint32_t size = vector->size;                                           \
+    uint32_t minRun = size;                                                 \
+    uint32_t remainder = 0;                                                 \
+    while (minRun >= VECTOR_INSERTION_SORT_MAX) {   /* natural runs shorter than this are extended by insertion */  \
+        remainder |= minRun & 1;                                            \
+        minRun >>= 1;                                                       \
+    }                                                                       \
+    minRun += remainder;                                                    \
+                                                                            \
+    uint32_t runStarts[VECTOR_MAX_RUN_STACK];                               \
+    uint32_t runLengths[VECTOR_MAX_RUN_STACK];                              \
+    uint32_t runCount = 0;                                                  \
+    for (uint32_t from = 0; from < size;) {                                 \
+        uint32_t end = NAME ##_runEnd(items, from, size);                   \
+        if (end - from < minRun) {                                          \
+            uint32_t forcedEnd = (size - from < minRun) ? size : from + minRun;  \
+            NAME ##_binaryInsertion(items, from, end, forcedEnd);           \
+            end = forcedEnd;                                                \
+        }                                                                   \
+        runStarts[runCount] = from;                                         \
+        runLengths[runCount++] = end - from;                                \
+        from = end;                                                         \
+                                                                            \
+        while (runCount > 1) {          /* keep run lengths growing faster than Fibonacci numbers down the stack */  \
+            uint32_t n = runCount - 2;                                      \
+            bool isLastRun = from >= size;                                  \
+            if (isLastRun || (n > 0 && runLengths[n - 1] <= runLengths[n] + runLengths[n + 1]) ||  \
+                (n > 1 && runLengths[n - 2] <= runLengths[n - 1] + runLengths[n])) {  \
+                n -= (n > 0 && runLengths[n - 1] < runLengths[n + 1]) ? 1 : 0;  \
+            } else if (runLengths[n] > runLengths[n + 1]) {                 \
+                break;                                                      \
+            }                                                               \
+            NAME ##_mergeRuns(items, runStarts[n], runStarts[n + 1], runStarts[n + 1] + runLengths[n + 1], scratch, scratchLength);  \
+            runLengths[n] += runLengths[n + 1];                             \
+            for (uint32_t r = n + 1; r + 1 < runCount; r++) {               \
+                runStarts[r] = runStarts[r + 1];                            \
+                runLengths[r] = runLengths[r + 1];                          \
+            }                                                               \
+            runCount--;                                                     \
+        }                                                                   \
+    }                                                                       \
+    return vector;                                                          \
+}                                                        \
+\
+static uint32_t NAME ##_partitionRange(TYPE *items, uint32_t from, uint32_t to) {  /* median of three pivot, returns its final index */  \
+    uint32_t middle = from + (to - from) / 2;                               \
+    TYPE tmp;                                                               \
+    if (COMPARE_FUN(items[middle], items[from]) < 0) { tmp = items[middle]; items[middle] = items[from]; items[from] = tmp; }  \
+    if (COMPARE_FUN(items[to - 1], items[middle]) < 0) { tmp = items[to - 1]; items[to - 1] = items[middle]; items[middle] = tmp; }  \
+    if (COMPARE_FUN(items[middle], items[from]) < 0) { tmp = items[middle]; items[middle] = items[from]; items[from] = tmp; }  \
+    tmp = items[middle];                                                    \
+    items[middle] = items[from];                                            \
+    items[from] = tmp;                                                      \
+    TYPE pivot = items[from];                                               \
+    uint32_t i = from;                                                      \
+    uint32_t j = to;                                                        \
+    while (true) {                  /* items[to - 1] and pivot itself stop the scans */  \
+        while (COMPARE_FUN(items[++i], pivot) < 0);                         \
+        while (COMPARE_FUN(items[--j], pivot) > 0);                         \
+        if (i >= j) break;                                                  \
+        tmp = items[i];                                                     \
+        items[i] = items[j];                                                \
+        items[j] = tmp;                                                     \
+    }                                                                       \
+    items[from] = items[j];                                                 \
+    items[j] = pivot;                                                       \
+    return j;                                                               \
+}                                                        \
+\
+static void NAME ##_select(TYPE *items, uint32_t from, uint32_t to, uint32_t nth) {  /* introselect, nth is inside [from, to) */  \
+    uint32_t depthLimit = 0;                                                \
+    for (uint32_t length = to - from; length > 1; length >>= 1) {          \
+        depthLimit += 2;                                                    \
+    }                                                                       \
+    while (to - from > VECTOR_INSERTION_SORT_MAX) {                         \
+        if (depthLimit-- == 0) break;   /* too many bad pivots, sorting keeps O(n log n) bound */  \
+        uint32_t pivotIndex = NAME ##_partitionRange(items, from, to);     \
+        if (pivotIndex == nth) return;                                      \
+        if (nth < pivotIndex) {                                             \
+            to = pivotIndex;                                                \
+        } else {                                                            \
+            from = pivotIndex + 1;                                          \
+        }                                                                   \
+    }                                                                       \
+    NAME ##_sortItems(items + from, to - from);                             \
+}                                                        \
+\
+static TYPE VECTOR_METHOD(NAME, NthElement)(VECTOR_TYPEDEF(NAME) *vector, uint32_t nth) {  /* items before nth are not greater, after are not less */  \
+    if (vector == NULL || nth >= vector->size) return (TYPE) {0};           \
+    NAME ##_select(vector->items, 0, vector->size, nth);                    \
+    return vector->items[nth];                                              \
+}                                                        \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, PartialSort)(VECTOR_TYPEDEF(NAME) *vector, uint32_t count) {  /* sorts only 'count' smallest items */  \
+    if (vector == NULL) return NULL;                                        \
+    if (count >= vector->size) return VECTOR_METHOD(NAME, Sort)(vector);    \
+    if (count == 0) return vector;                                          \
+    NAME ##_select(vector->items, 0, vector->size, count - 1);              \
+    NAME ##_sortItems(vector->items, count - 1);                            \
+    return vector;                                                          \
+}                                                        \
+\
+static void NAME ##_siftDown(TYPE *items, uint32_t root, uint32_t size) {   /* min-heap */  \
+    TYPE value = items[root];                                               \
+    for (uint32_t child = 2 * root + 1; child < size; child = 2 * root + 1) {  \
+        if (child + 1 < size && COMPARE_FUN(items[child + 1], items[child]) < 0) child++;  \
+        if (COMPARE_FUN(items[child], value) >= 0) break;                   \
+        items[root] = items[child];                                         \
+        root = child;                                                       \
+    }                                                                       \
+    items[root] = value;                                                    \
+}                                                        \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, TopK)(VECTOR_TYPEDEF(NAME) *vector, uint32_t count) {  /* 'count' greatest items first, descending */  \
+    if (vector == NULL) return NULL;                                        \
+    if (count == 0) return vector;                  /* no heap, items are kept in place */  \
+    if (count > vector->size) count = vector->size;                         \
+    TYPE *items = vector->items;                                            \
+    for (uint32_t i = count / 2; i-- > 0;) {                                \
+        NAME ##_siftDown(items, i, count);                                  \
+    }                                                                       \
+    for (uint32_t i = count; i < vector->size; i++) {   /* heap root is the least of kept items */  \
+        if (COMPARE_FUN(items[i], items[0]) > 0) {                          \
+            TYPE tmp = items[0];                                            \
+            items[0] = items[i];                                            \
+            items[i] = tmp;                                                 \
+            NAME ##_siftDown(items, 0, count);                              \
+        }                                                                   \
+    }                                                                       \
+    for (uint32_t end = count; end > 1; end--) {                            \
+        TYPE tmp = items[0];                                                \
+        items[0] = items[end - 1];                                          \
+        items[end - 1] = tmp;                                               \
+        NAME ##_siftDown(items, 0, end - 1);                                \
+    }                                                                       \
+    return vector;                                                          \
+}                                                        \
+\
+static void NAME ##_selectRanks(TYPE *items, uint32_t from, uint32_t to, uint32_t *ranks, uint32_t count) {  \
+    while (count > 0 && ranks[0] < from) {                                  \
+        ranks++;                                                            \
+        count--;                                                            \
+    }                                                                       \
+    while (count > 0 && ranks[count - 1] >= to) {                           \
+        count--;                                                            \
+    }                                                                       \
+    if (count == 0 || to - from <= 1) return;                               \
+    if (to - from <= VECTOR_INSERTION_SORT_MAX) {                           \
+        NAME ##_sortItems(items + from, to - from);                         \
+        return;                                                             \
+    }                                                                       \
+    uint32_t middle = count / 2;    /* middle rank splits range and remaining ranks in halves */  \
+    uint32_t nth = ranks[middle];                                           \
+    NAME ##_select(items, from, to, nth);                                   \
+    NAME ##_selectRanks(items, from, nth, ranks, middle);                   \
+    NAME ##_selectRanks(items, nth + 1, to, ranks + middle + 1, count - middle - 1);  \
+}                                                        \
+\
+static bool VECTOR_METHOD(NAME, SelectRanks)(VECTOR_TYPEDEF(NAME) *vector, uint32_t ranks[], uint32_t count) {  /* ranks must be ascending */  \
+    if (vector == NULL || (ranks == NULL && count > 0)) return false;       \
+    for (uint32_t i = 0; i < count; i++) {                                  \
+        if (ranks[i] >= vector->size || (i > 0 && ranks[i] < ranks[i - 1])) return false;  \
+    }                                                                       \
+    NAME ##_selectRanks(vector->items, 0, vector->size, ranks, count);      \
+    return true;                                                            \
+}                                                        \
+\
+static bool VECTOR_METHOD(NAME, Quantiles)(VECTOR_TYPEDEF(NAME) *vector, double quantiles[], TYPE results[], uint32_t count) {  \
+    if (vector == NULL || vector->size == 0 || count > VECTOR_MAX_QUANTILES) return false;  /* nearest rank of q * (size - 1) */  \
+    if ((quantiles == NULL || results == NULL) && count > 0) return false;  \
+    uint32_t quantileRanks[VECTOR_MAX_QUANTILES];   /* in order of quantiles */  \
+    uint32_t ranks[VECTOR_MAX_QUANTILES];           /* ascending for selection */  \
+    for (uint32_t i = 0; i < count; i++) {                                  \
+        if (!(quantiles[i] >= 0 && quantiles[i] <= 1)) return false;        \
+        quantileRanks[i] = (uint32_t) (quantiles[i] * (vector->size - 1) + 0.5);  \
+        uint32_t j = i;                                                     \
+        for (; j > 0 && ranks[j - 1] > quantileRanks[i]; j--) {             \
+            ranks[j] = ranks[j - 1];                                        \
+        }                                                                   \
+        ranks[j] = quantileRanks[i];                                        \
+    }                                                                       \
+    NAME ##_selectRanks(vector->items, 0, vector->size, ranks, count);      \
+    for (uint32_t i = 0; i < count; i++) {                                  \
+        results[i] = vector->items[quantileRanks[i]];                       \
+    }                                                                       \
+    return true;                                                            \
+}                                                        \
+\
+static bool NAME ##_isIndexLess(TYPE *items, uint32_t one, uint32_t two) {  \
+    return COMPARE_FUN(items[one], items[two]) < 0;                         \
+}                                                        \
+\
+static bool VECTOR_METHOD(NAME, ArgSort)(VECTOR_TYPEDEF(NAME) *vector, uint32_t indexes[], uint32_t length) {  /* stable, vector is not changed */  \
+    if (vector == NULL || indexes == NULL || length < VECTOR_ARG_SORT_LENGTH(vector->size)) return false;  \
+    TYPE *items = vector->items;                                            \
+    uint32_t size = vector->size;                                           \
+    for (uint32_t from = 0; from < size; from += VECTOR_INSERTION_SORT_MAX) {  /* insertion sorted blocks */  \
+        uint32_t to = (size - from > VECTOR_INSERTION_SORT_MAX) ? from + VECTOR_INSERTION_SORT_MAX : size;  \
+        for (uint32_t i = from; i < to; i++) {                              \
+            uint32_t j = i;                                                 \
+            for (; j > from && NAME ##_isIndexLess(items, i, indexes[j - 1]); j--) {  \
+                indexes[j] = indexes[j - 1];                                \
+            }                                                               \
+            indexes[j] = i;                                                 \
+        }                                                                   \
+    }                                                                       \
+    uint32_t *source = indexes;                                             \
+    uint32_t *dest = indexes + size;    /* second half is merge buffer */   \
+    for (uint32_t width = VECTOR_INSERTION_SORT_MAX; width < size; width *= 2) {  \
+        for (uint32_t from = 0; from < size; from += 2 * width) {           \
+            uint32_t middle = (size - from > width) ? from + width : size;  \
+            uint32_t to = (size - middle > width) ? middle + width : size;  \
+            uint32_t i = from;                                              \
+            uint32_t j = middle;                                            \
+            for (uint32_t k = from; k < to; k++) {                          \
+                bool isLeft = j >= to || (i < middle && !NAME ##_isIndexLess(items, source[j], source[i]));  \
+                dest[k] = isLeft ? source[i++] : source[j++];               \
+            }                                                               \
+        }                                                                   \
+        uint32_t *tmp = source;                                             \
+        source = dest;                                                      \
+        dest = tmp;                                                         \
+    }                                                                       \
+    if (source != indexes) {                                                \
+        memcpy(indexes, source, sizeof(uint32_t) * size);                   \
+    }                                                                       \
+    return true;                                                            \
+}                                                        \
+\
+static bool VECTOR_METHOD(NAME, Gather)(VECTOR_TYPEDEF(NAME) *dest, VECTOR_TYPEDEF(NAME) *source, uint32_t indexes[], uint32_t count) {  \
+    if (dest == NULL || source == NULL || dest == source || count > dest->capacity) return false;  /* dest[i] = source[indexes[i]] */  \
+    for (uint32_t i = 0; i < count; i++) {                                  \
+        if (indexes[i] >= source->size) return false;                       \
+    }                                                                       \
+    if (sizeof(TYPE) == sizeof(uint32_t) || sizeof(TYPE) == sizeof(uint64_t)) {  \
+        vectorKernelGather(dest->items, source->items, source->size, indexes, count, sizeof(TYPE));  \
+    } else {                                                                \
+        for (uint32_t i = 0; i < count; i++) {                              \
+            dest->items[i] = source->items[indexes[i]];                     \
+        }                                                                   \
+    }                                                                       \
+    dest->size = count;                                                     \
+    return true;                                                            \
+}                                                        \
+\
+static bool VECTOR_METHOD(NAME, Scatter)(VECTOR_TYPEDEF(NAME) *dest, VECTOR_TYPEDEF(NAME) *source, uint32_t indexes[]) {  \
+    if (dest == NULL || source == NULL || dest == source) return false;    /* dest[indexes[i]] = source[i] */  \
+    uint32_t size = dest->size;                                             \
+    for (uint32_t i = 0; i < source->size; i++) {                           \
+        if (indexes[i] >= dest->capacity) return false;                     \
+        if (indexes[i] >= size) size = indexes[i] + 1;                      \
+    }                                                                       \
+    for (uint32_t i = 0; i < source->size; i++) {                           \
+        dest->items[indexes[i]] = source->items[i];                         \
+    }                                                                       \
+    dest->size = size;                                                      \
+    return true;                                                            \
+}                                                        \
+\
+typedef uint64_t (*VECTOR_KEY_TYPEDEF(NAME))(TYPE item, void *context);    /* see vectorSignedKey() and vectorFloatKey() */  \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, SortByKey)(VECTOR_TYPEDEF(NAME) *vector, VECTOR_KEY_TYPEDEF(NAME) keyOf, void *context,  \
+                                                           VectorSortKey keys[], uint32_t length) {  /* stable, each item moves once */  \
+    if (vector == NULL || keyOf == NULL || keys == NULL || length < VECTOR_SORT_BY_KEY_LENGTH(vector->size)) return NULL;  \
+    TYPE *items = vector->items;                                            \
+    uint32_t size = vector->size;                                           \
+    if (size == 0) return vector;                                           \
+    for (uint32_t i = 0; i < size; i++) {   /* key is extracted once per item */  \
+        keys[i].key = keyOf(items[i], context);                             \
+        keys[i].index = i;                                                  \
+    }                                                                       \
+    VectorSortKey *sorted = vectorKernelRadixSortKeys(keys, keys + size, size);  \
+    for (uint32_t start = 0; start < size; start++) {   /* position i takes item sorted[i].index, placed items point to themselves */  \
+        if (sorted[start].index == start) continue;                         \
+        TYPE item = items[start];                                           \
+        uint32_t current = start;                                           \
+        while (sorted[current].index != start) {                            \
+            uint32_t next = sorted[current].index;                          \
+            items[current] = items[next];                                   \
+            sorted[current].index = current;                                \
+            current = next;                                                 \
+        }                                                                   \
+        items[current] = item;                                              \
+        sorted[current].index = current;                                    \
+    }                                                                       \
+    return vector;                                                          \
+}                                                        \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, ParallelSort)(VECTOR_TYPEDEF(NAME) *vector, ThreadPool pool) {  \
+    if (vector == NULL) return NULL;                                        \
+    if (vector->size >= PARALLEL_SORT_MIN_SIZE && parallelRadixSort(vector->items, vector->size, NAME ##_kind(), pool)) {  \
+        return vector;                  /* 32 and 64-bit integers */        \
+    }                                                                       \
+    if (vector->size < PARALLEL_SORT_MIN_SIZE || getThreadPoolSize(pool) < 2 || VECTOR_IS_COUNTING_KIND(NAME ##_kind())) {  \
+        return VECTOR_METHOD(NAME, Sort)(vector);   /* counting sort of narrow integers is faster than threads */  \
+    }                                                                       \
+    parallelSort(vector->items, vector->size, sizeof(TYPE), NAME ##_compare, pool);  \
+    return vector;                                                          \
+}                                                        \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, ParallelForEach)(VECTOR_TYPEDEF(NAME) *vector, ParallelItemFunction function, void *context, ThreadPool pool) {  \
+    if (vector == NULL) return NULL;                                        \
+    parallelForEach(vector->items, vector->size, sizeof(TYPE), function, context, pool);  \
+    return vector;                                                          \
+}                                                                           \
+\
+static bool VECTOR_METHOD(NAME, ParallelMap)(VECTOR_TYPEDEF(NAME) *vector, void *results, uint32_t resultSize, ParallelMapFunction function, void *context, ThreadPool pool) {  \
+    if (vector == NULL || results == NULL || function == NULL) return false;  \
+    parallelMap(vector->items, results, vector->size, sizeof(TYPE), resultSize, function, context, pool);  \
+    return true;                                                            \
+}                                                                           \
+\
+static uint32_t NAME ##_searchRange(const void *items, uint32_t begin, uint32_t end, void *context) {  \
+    TYPE *values = (TYPE *) items;                                          \
+    TYPE value = *((TYPE *) context);                                       \
+    for (uint32_t i = begin; i < end; i++) {                                \
+        if (COMPARE_FUN(values[i], value) == 0) return i;                   \
+    }                                                                       \
+    return end;                                                             \
+}                                                                           \
+\
+static int32_t VECTOR_METHOD(NAME, ParallelIndexOf)(VECTOR_TYPEDEF(NAME) *vector, TYPE value, ThreadPool pool) {  \
+    if (vector == NULL) return -1;                                          \
+    return parallelSearch(vector->items, vector->size, sizeof(TYPE), NAME ##_searchRange, &value, pool);  \
+}                                                                           \
+\
+static bool VECTOR_METHOD(NAME, ParallelReduce)(VECTOR_TYPEDEF(NAME) *vector, const ParallelReducer *reducer, void *result, ThreadPool pool) {  \
+    return vector != NULL && parallelReduce(vector->items, vector->size, sizeof(TYPE), reducer, result, pool);  \
+}                                                                           \
+\
+typedef struct NAME ##_MergePath {                                          \
+    TYPE *first;                                                            \
+    uint32_t firstSize;                                                     \
+    TYPE *second;                                                           \
+    uint32_t secondSize;                                                    \
+    VectorIteratorType operation;                                           \
+} NAME ##_MergePath;                                                        \
+\
+static uint32_t NAME ##_findDescent(const void *items, uint32_t begin, uint32_t end, void *context) {  \
+    (void) context;                                                         \
+    TYPE *values = (TYPE *) items;                                          \
+    for (uint32_t i = (begin > 0) ? begin : 1; i < end; i++) {              \
+        if (COMPARE_FUN(values[i - 1], values[i]) > 0) return i;            \
+    }                                                                       \
+    return end;                                                             \
+}                                                                           \
+\
+static void NAME ##_parallelEnsureSorted(VECTOR_TYPEDEF(NAME) *vector, ThreadPool pool) {  \
+    if (parallelSearch(vector->items, vector->size, sizeof(TYPE), NAME ##_findDescent, NULL, pool) >= 0) {  \
+        VECTOR_METHOD(NAME, ParallelSort)(vector, pool);                    \
+    }                                                                       \
+}                                                                           \
+\
+static void NAME ##_mergeSplit(uint32_t diagonal, uint32_t *firstIndex, uint32_t *secondIndex, void *context) {  \
+    NAME ##_MergePath *merge = context;                                     \
+    uint32_t low = (diagonal > merge->secondSize) ? diagonal - merge->secondSize : 0;  \
+    uint32_t high = (diagonal < merge->firstSize) ? diagonal : merge->firstSize;        \
+    while (low < high) {    /* merge path search, ties are taken from first input */    \
+        uint32_t middle = low + (high - low) / 2;                           \
+        if (COMPARE_FUN(merge->first[middle], merge->second[diagonal - middle - 1]) <= 0) {  \
+            low = middle + 1;                                               \
+        } else {                                                            \
+            high = middle;                                                  \
+        }                                                                   \
+    }                                                                       \
+    uint32_t i = low;                                                       \
+    uint32_t j = diagonal - low;                                            \
+    if (i == merge->firstSize && j == merge->secondSize) {                  \
+        *firstIndex = i;                                                    \
+        *secondIndex = j;                                                   \
+        return;                                                             \
+    }                                                                       \
+    bool isFirst = j == merge->secondSize || (i < merge->firstSize && COMPARE_FUN(merge->first[i], merge->second[j]) <= 0);  \
+    TYPE value = isFirst ? merge->first[i] : merge->second[j];              \
+    *firstIndex = NAME ##_gallop(merge->first, 0, i, value);    /* whole run of equal values goes to next segment */  \
+    *secondIndex = NAME ##_gallop(merge->second, 0, j, value);              \
+}                                                                           \
+\
+static uint32_t NAME ##_mergeSegment(const MergePathSegment *segment, bool isCounting, void *context) {  \
+    NAME ##_MergePath *merge = context;                                     \
+    TYPE *first = merge->first;                                             \
+    TYPE *second = merge->second;                                           \
+    TYPE *output = isCounting ? NULL : (TYPE *) segment->output + segment->outputFrom;  \
+    uint32_t i = segment->firstFrom;                                        \
+    uint32_t j = segment->secondFrom;                                       \
+    uint32_t count = 0;                                                     \
+    if (merge->operation == VECTOR_ITERATOR_SUBTRACT) {     /* each equal pair cancels, same as <type>VecSubtract() */  \
+        for (; i < segment->firstTo && j < segment->secondTo;) {            \
+            int result = COMPARE_FUN(first[i], second[j]);                  \
+            if (result < 0) {                                               \
+                if (output != NULL) output[count] = first[i];               \
+                count++;                                                    \
+                i++;                                                        \
+            } else {                                                        \
+                i += result == 0;                                           \
+                j++;                                                        \
+            }                                                               \
+        }                                                                   \
+        if (output != NULL) memcpy(output + count, first + i, sizeof(TYPE) * (segment->firstTo - i));  \
+        return count + segment->firstTo - i;                                \
+    }                                                                       \
+    while (i < segment->firstTo && j < segment->secondTo) {                 \
+        int result = COMPARE_FUN(first[i], second[j]);                      \
+        if (result != 0 && merge->operation == VECTOR_ITERATOR_INTERSECT) { \
+            if (result < 0) {                                               \
+                i = NAME ##_gallop(first, i, segment->firstTo, second[j]);  \
+            } else {                                                        \
+                j = NAME ##_gallop(second, j, segment->secondTo, first[i]); \
+            }                                                               \
+            continue;                                                       \
+        }                                                                   \
+        TYPE value = (result <= 0) ? first[i] : second[j];  /* first input is kept for equal values */  \
+        if (output != NULL) output[count] = value;                          \
+        count++;                                                            \
+        while (i < segment->firstTo && COMPARE_FUN(first[i], value) == 0) i++;     \
+        while (j < segment->secondTo && COMPARE_FUN(second[j], value) == 0) j++;   \
+    }                                                                       \
+    while (merge->operation == VECTOR_ITERATOR_UNION && (i < segment->firstTo || j < segment->secondTo)) {  \
+        TYPE value = (i < segment->firstTo) ? first[i] : second[j];         \
+        if (output != NULL) output[count] = value;                          \
+        count++;                                                            \
+        while (i < segment->firstTo && COMPARE_FUN(first[i], value) == 0) i++;     \
+        while (j < segment->secondTo && COMPARE_FUN(second[j], value) == 0) j++;   \
+    }                                                                       \
+    return count;                                                           \
+}                                                                           \
+\
+static bool NAME ##_parallelMerge(VECTOR_TYPEDEF(NAME) *destVector, TYPE *second, uint32_t secondSize, VectorIteratorType operation, ThreadPool pool) {  \
+    uint32_t capacity = (operation == VECTOR_ITERATOR_UNION) ? destVector->size + secondSize : destVector->size;  \
+    NAME ##_MergePath merge = {                                             \
+            .first = destVector->items,                                     \
+            .firstSize = destVector->size,                                  \
+            .second = second,                                               \
+            .secondSize = secondSize,                                       \
+            .operation = operation                                          \
+    };                                                                      \
+    uint32_t size;                                                          \
+    if (!parallelMergeIntoFirst(destVector->items, destVector->size, secondSize, sizeof(TYPE), capacity,  \
+                                NAME ##_mergeSplit, NAME ##_mergeSegment, &merge, pool, &size)) {  \
+        return false;                                                       \
+    }                                                                       \
+    destVector->size = size;                                                \
+    return true;                                                            \
+}                                                                           \
+\
+static bool NAME ##_isParallelMerge(VECTOR_TYPEDEF(NAME) *destVector, VECTOR_TYPEDEF(NAME) *sourceVector, ThreadPool pool) {  \
+    return (uint64_t) destVector->size + sourceVector->size >= PARALLEL_MERGE_MIN_SIZE && getThreadPoolSize(pool) >= 2 &&  \
+           !VECTOR_IS_COUNTING_KIND(NAME ##_kind());    /* counting operations of narrow integers are faster than threads */  \
+}                                                                           \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, ParallelUnion)(VECTOR_TYPEDEF(NAME) *destVector, VECTOR_TYPEDEF(NAME) *sourceVector, ThreadPool pool) {  \
+    if (destVector == NULL || sourceVector == NULL) return NULL;            \
+    if (!NAME ##_isParallelMerge(destVector, sourceVector, pool) ||         \
+        destVector->size + (uint64_t) sourceVector->size > destVector->capacity) {  /* items that don't fit are dropped by Union() */  \
+        return VECTOR_METHOD(NAME, Union)(destVector, sourceVector);        \
+    }                                                                       \
+    NAME ##_parallelEnsureSorted(destVector, pool);                         \
+    TYPE *second = sourceVector->items;                                     \
+    if (parallelSearch(second, sourceVector->size, sizeof(TYPE), NAME ##_findDescent, NULL, pool) >= 0) {  \
+        VECTOR_TYPEDEF(NAME) tail = {.items = destVector->items + destVector->size, .size = sourceVector->size, .capacity = sourceVector->size};  \
+        memcpy(tail.items, second, sizeof(TYPE) * tail.size);   /* source is sorted in spare capacity, it's not changed by Union() */  \
+        VECTOR_METHOD(NAME, ParallelSort)(&tail, pool);                     \
+        second = tail.items;                                                \
+    }                                                                       \
+    if (!NAME ##_parallelMerge(destVector, second, sourceVector->size, VECTOR_ITERATOR_UNION, pool)) {  \
+        return VECTOR_METHOD(NAME, Union)(destVector, sourceVector);        \
+    }                                                                       \
+    return destVector;                                                      \
+}                                                                           \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, ParallelIntersect)(VECTOR_TYPEDEF(NAME) *destVector, VECTOR_TYPEDEF(NAME) *sourceVector, ThreadPool pool) {  \
+    if (destVector == NULL || sourceVector == NULL) return NULL;            \
+    if (!NAME ##_isParallelMerge(destVector, sourceVector, pool)) return VECTOR_METHOD(NAME, Intersect)(destVector, sourceVector);  \
+    NAME ##_parallelEnsureSorted(destVector, pool);                         \
+    NAME ##_parallelEnsureSorted(sourceVector, pool);                       \
+    if (!NAME ##_parallelMerge(destVector, sourceVector->items, sourceVector->size, VECTOR_ITERATOR_INTERSECT, pool)) {  \
+        return VECTOR_METHOD(NAME, Intersect)(destVector, sourceVector);    \
+    }                                                                       \
+    return destVector;                                                      \
+}                                                                           \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, ParallelSubtract)(VECTOR_TYPEDEF(NAME) *destVector, VECTOR_TYPEDEF(NAME) *sourceVector, ThreadPool pool) {  \
+    if (destVector == NULL || sourceVector == NULL) return NULL;            \
+    if (!NAME ##_isParallelMerge(destVector, sourceVector, pool)) return VECTOR_METHOD(NAME, Subtract)(destVector, sourceVector);  \
+    NAME ##_parallelEnsureSorted(destVector, pool);                         \
+    NAME ##_parallelEnsureSorted(sourceVector, pool);                       \
+    if (!NAME ##_parallelMerge(destVector, sourceVector->items, sourceVector->size, VECTOR_ITERATOR_SUBTRACT, pool)) {  \
+        return VECTOR_METHOD(NAME, Subtract)(destVector, sourceVector);     \
+    }                                                                       \
+    return destVector;                                                      \
+}                                                                           \
+\
+
+
+// Scratch length for <type>VecStableSort() that avoids in place merging
+#define VECTOR_STABLE_SORT_SCRATCH_LENGTH(SIZE) (((SIZE) + 1) / 2)
 
+// Index buffer length for <type>VecArgSort(), second half is used for merging
+#define VECTOR_ARG_SORT_LENGTH(SIZE) (2 * (SIZE))
 
-#define CREATE_VECTOR_TYPE_1(TYPE) CREATE_VECTOR_TYPE_NAME(TYPE, TYPE, COMPARATOR_FOR_TYPE(TYPE))
-#define CREATE_VECTOR_TYPE_2(TYPE, NAME) CREATE_VECTOR_TYPE_NAME(TYPE, NAME, COMPARATOR_FOR_TYPE(TYPE))
+// Key buffer length for <type>VecSortByKey(), second half is used by radix passes
+#define VECTOR_SORT_BY_KEY_LENGTH(SIZE) (2 * (SIZE))
+
+// Custom comparator can define any order, so only generic code is used for such vectors
+#define CREATE_VECTOR_TYPE_NAME(TYPE, NAME, COMPARE_FUN) CREATE_VECTOR_TYPE_KIND(TYPE, NAME, COMPARE_FUN, VECTOR_ELEMENT_ANY)
+
+#define CREATE_VECTOR_TYPE_1(TYPE) CREATE_VECTOR_TYPE_KIND(TYPE, TYPE, COMPARATOR_FOR_TYPE(TYPE), VECTOR_ELEMENT_KIND(TYPE))
+#define CREATE_VECTOR_TYPE_2(TYPE, NAME) CREATE_VECTOR_TYPE_KIND(TYPE, NAME, COMPARATOR_FOR_TYPE(TYPE), VECTOR_ELEMENT_KIND(TYPE))
 #define CREATE_VECTOR_TYPE_3(TYPE, NAME, COMPARE_FUN) CREATE_VECTOR_TYPE_NAME(TYPE, NAME, COMPARE_FUN)
 #define CREATE_VECTOR_TYPE_MACRO(_1, _2, _3, FUN, ...) FUN
 
@@ -334,6 +1464,13 @@ static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, Disjunction)(VECTOR_TYPEDEF(NA
 #define NEW_VECTOR_1024(...) NEW_VECTOR(__VA_ARGS__, 1024)
 
 
+#define VECTOR_ITERATOR(NAME, VECTOR) VECTOR_METHOD(NAME, Iterator)(&(VECTOR_ITERATOR_TYPEDEF(NAME)){0}, VECTOR)
+#define VECTOR_UNION_ITERATOR(NAME, LEFT, RIGHT) VECTOR_METHOD(NAME, UnionIterator)(&(VECTOR_ITERATOR_TYPEDEF(NAME)){0}, LEFT, RIGHT)
+#define VECTOR_INTERSECT_ITERATOR(NAME, LEFT, RIGHT) VECTOR_METHOD(NAME, IntersectIterator)(&(VECTOR_ITERATOR_TYPEDEF(NAME)){0}, LEFT, RIGHT)
+#define VECTOR_SUBTRACT_ITERATOR(NAME, LEFT, RIGHT) VECTOR_METHOD(NAME, SubtractIterator)(&(VECTOR_ITERATOR_TYPEDEF(NAME)){0}, LEFT, RIGHT)
+#define VECTOR_DISJUNCTION_ITERATOR(NAME, LEFT, RIGHT) VECTOR_METHOD(NAME, DisjunctionIterator)(&(VECTOR_ITERATOR_TYPEDEF(NAME)){0}, LEFT, RIGHT)
+
+
 #define VEC_ARGS_LENGTH(NAME, TYPE, ...)  (sizeof((TYPE []){__VA_ARGS__})/sizeof(TYPE))
 #define NEW_VECTOR_OF(CAPACITY, NAME, TYPE, ...) new ## NAME ## BuffVectorOf(&(VECTOR_TYPEDEF(NAME)){0}, (TYPE [CAPACITY]){__VA_ARGS__}, CAPACITY, VEC_ARGS_LENGTH(NAME, TYPE, __VA_ARGS__))
 
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Vector.h"
+
+// Append-only vector for many writer threads. Slots are reserved by atomic fetch-add and live in segments of doubling
+// capacity, so growth never moves items. Size visible to readers is advanced only over written slots,
+// so items below getConcurrentVectorSize() can be read while other threads keep appending.
+
+#define CONCURRENT_VECTOR_MIN_SEGMENT 16    // first segment capacity, rounded up to power of two
+
+typedef struct ConcurrentVector *ConcurrentVector;
+
+ConcurrentVector getConcurrentVectorInstance(uint32_t firstSegmentCapacity);
+
+// Lock-free, false when vector is full or segment can't be allocated. Allocation failure is sticky: published size
+// stops before failed slot and adds that start after isConcurrentVectorFailed() turns true return false.
+// Add racing with the failure may still return true although its item is never published, adds don't wait
+// for slower writers, so only published size tells which items are in vector
+bool concurrentVectorAdd(ConcurrentVector vector, VectorValueType item);
+VectorValueType concurrentVectorGet(ConcurrentVector vector, uint32_t index);   // NULL for index not yet published
+
+uint32_t getConcurrentVectorSize(ConcurrentVector vector);     // published size, every item below it is written
+bool isConcurrentVectorEmpty(ConcurrentVector vector);
+bool isConcurrentVectorFailed(ConcurrentVector vector);   // true after segment allocation failure
+
+void concurrentVectorDelete(ConcurrentVector vector);  // no other thread can use vector at this point
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Sorts element streams larger than memory. Input is sorted in memory budget sized runs that are spilled to temporary
+// files, then runs are k-way merged with large sequential reads. Output is pulled in chunks or written to a file.
+
+#define EXTERNAL_SORT_MIN_BLOCK (64 * 1024)  // smallest read block per run during merge, limits merge ways for budget
+
+typedef struct ExternalSort *ExternalSort;
+typedef int (*ExternalSortComparator)(const void *one, const void *two);    // same contract as qsort() comparator
+
+ExternalSort getExternalSortInstance(uint32_t elementSize, size_t memoryBudget, ExternalSortComparator comparator);
+
+bool externalSortAdd(ExternalSort sort, const void *items, uint32_t count);
+bool externalSortFinish(ExternalSort sort);     // no more input, prepares merge
+
+// Copies next sorted elements, returns their count, 0 when all elements are read or on error.
+// Generated BufferVector can be filled with: 'vec->size = externalSortRead(sort, vec->items, vec->capacity)'
+uint32_t externalSortRead(ExternalSort sort, void *items, uint32_t capacity);
+bool externalSortWrite(ExternalSort sort, FILE *output);    // writes all remaining sorted elements
+
+uint64_t getExternalSortSize(ExternalSort sort);            // added element count
+uint32_t getExternalSortRunCount(ExternalSort sort);        // runs spilled to temporary files
+bool isExternalSortFailed(ExternalSort sort);               // allocation or I/O error happened
+
+void externalSortDelete(ExternalSort sort);
@@ -0,0 +1,349 @@
+#pragma once
+
+#include <math.h>
+#include "BufferVector.h"
+
+#define ACCUMULATOR_FOR_TYPE(TYPE) TYPE ## Accumulator     // widened result type of <type>VecSum()
+
+typedef int64_t intAccumulator;
+typedef int64_t longAccumulator;
+typedef int64_t charAccumulator;
+typedef int64_t int8_tAccumulator;
+typedef uint64_t uint8_tAccumulator;
+typedef int64_t int16_tAccumulator;
+typedef uint64_t uint16_tAccumulator;
+typedef int64_t int32_tAccumulator;
+typedef uint64_t uint32_tAccumulator;
+typedef int64_t int64_tAccumulator;     // 64-bit sums wrap on overflow
+typedef uint64_t uint64_tAccumulator;
+typedef double floatAccumulator;
+typedef double doubleAccumulator;
+
+// Methods for vectors of arithmetic types, generated in addition to CREATE_VECTOR_TYPE(TYPE) or CREATE_VECTOR_TYPE(TYPE, NAME)
+#define CREATE_NUMBER_VECTOR_METHODS_NAME(TYPE, NAME) \
+\
+static inline uint32_t NAME ##_hashSlot(TYPE value, uint32_t length) {  \
+    uint32_t hash;                                                      \
+    if (NAME ##_kind() == VECTOR_ELEMENT_F32 || NAME ##_kind() == VECTOR_ELEMENT_F64) {  \
+        if (value != value) return 0;   /* every NaN is equal to other NaN by comparator */   \
+        if (value == 0) value = 0;      /* -0.0 is equal to 0.0 */     \
+        uint64_t bits = 0;              /* hash code of float drops fraction, so bit pattern is hashed */   \
+        memcpy(&bits, &value, sizeof(TYPE) < sizeof(bits) ? sizeof(TYPE) : sizeof(bits));   \
+        hash = (uint32_t) ((bits * 0x9E3779B97F4A7C15ull) >> 32);      \
+    } else {                                                            \
+        hash = (uint32_t) HASH_CODE_FOR_TYPE(TYPE)(value) * 0x9E3779B1u;   /* spread identity hash codes */   \
+    }                                                                   \
+    return (uint32_t) (((uint64_t) hash * length) >> 32);              \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, RemoveDupStable)(VECTOR_TYPEDEF(NAME) *vector, uint32_t *scratch, uint32_t scratchLength) { \
+    if (vector == NULL || scratch == NULL || scratchLength < 2 * (uint64_t) vector->size) return NULL;  \
+    memset(scratch, 0, sizeof(uint32_t) * scratchLength);   /* slot keeps kept item index + 1, zero is empty */   \
+    uint32_t j = 0;                                                     \
+    for (uint32_t i = 0; i < vector->size; i++) {                       \
+        TYPE value = vector->items[i];                                  \
+        uint32_t slot = NAME ##_hashSlot(value, scratchLength);         \
+        bool isDuplicate = false;                                       \
+        while (scratch[slot] != 0) {                                    \
+            if (COMPARATOR_FOR_TYPE(TYPE)(vector->items[scratch[slot] - 1], value) == 0) {   \
+                isDuplicate = true;                                     \
+                break;                                                  \
+            }                                                           \
+            slot = (slot + 1 == scratchLength) ? 0 : slot + 1;          \
+        }                                                               \
+        if (!isDuplicate) {                                             \
+            vector->items[j++] = value;                                 \
+            scratch[slot] = j;                                          \
+        }                                                               \
+    }                                                                   \
+    vector->size = j;                                                   \
+    return vector;                                                      \
+}                                      \
+\
+static inline bool NAME ##_isMatching(TYPE value, VectorCompareOperator compareOperator, TYPE first, TYPE second) {  \
+    switch (compareOperator) {                                          \
+        case VECTOR_LESS:                                               \
+            return value < first;                                       \
+        case VECTOR_LESS_OR_EQUAL:                                      \
+            return value <= first;                                      \
+        case VECTOR_GREATER:                                            \
+            return value > first;                                       \
+        case VECTOR_GREATER_OR_EQUAL:                                   \
+            return value >= first;                                      \
+        case VECTOR_EQUAL:                                              \
+            return value == first;                                      \
+        case VECTOR_NOT_EQUAL:                                          \
+            return value != first;                                      \
+        case VECTOR_BETWEEN:                                            \
+            return value >= first && value <= second;                   \
+    }                                                                   \
+    return false;                                                       \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * NAME ##_compactWhere(VECTOR_TYPEDEF(NAME) *vector, VectorCompareOperator compareOperator, TYPE first, TYPE second, bool isRetained) {  \
+    if (vector == NULL) return NULL;                                    \
+    VectorElementKind kind = NAME ##_kind();                            \
+    if (kind == VECTOR_ELEMENT_I32 || kind == VECTOR_ELEMENT_U32 || kind == VECTOR_ELEMENT_F32) {  \
+        vector->size = vectorKernelCompact32(vector->items, vector->size, kind, compareOperator, &first, &second, isRetained);  \
+        return vector;                                                  \
+    }                                                                   \
+    uint32_t j = 0;                                                     \
+    for (uint32_t i = 0; i < vector->size; i++) {                       \
+        TYPE value = vector->items[i];                                  \
+        vector->items[j] = value;                                       \
+        j += NAME ##_isMatching(value, compareOperator, first, second) == isRetained;  \
+    }                                                                   \
+    vector->size = j;                                                   \
+    return vector;                                                      \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, RetainWhere)(VECTOR_TYPEDEF(NAME) *vector, VectorCompareOperator compareOperator, TYPE value) {  \
+    return NAME ##_compactWhere(vector, compareOperator, value, value, true);  \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, RemoveWhere)(VECTOR_TYPEDEF(NAME) *vector, VectorCompareOperator compareOperator, TYPE value) {  \
+    return NAME ##_compactWhere(vector, compareOperator, value, value, false); \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, RetainBetween)(VECTOR_TYPEDEF(NAME) *vector, TYPE low, TYPE high) {  \
+    return NAME ##_compactWhere(vector, VECTOR_BETWEEN, low, high, true);  \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, RemoveBetween)(VECTOR_TYPEDEF(NAME) *vector, TYPE low, TYPE high) {  \
+    return NAME ##_compactWhere(vector, VECTOR_BETWEEN, low, high, false); \
+}                                      \
+\
+static inline bool NAME ##_isReduceKernel(void) {   \
+    VectorElementKind kind = NAME ##_kind();                            \
+    return kind == VECTOR_ELEMENT_I32 || kind == VECTOR_ELEMENT_U32 || kind == VECTOR_ELEMENT_F32 || kind == VECTOR_ELEMENT_F64;  \
+}                                      \
+\
+static bool VECTOR_METHOD(NAME, MinMax)(VECTOR_TYPEDEF(NAME) *vector, TYPE *min, TYPE *max) {  /* single pass, false when empty */  \
+    if (vector == NULL || vector->size == 0 || min == NULL || max == NULL) return false;  \
+    if (NAME ##_isReduceKernel()) {                                     \
+        vectorKernelMinMax(vector->items, vector->size, NAME ##_kind(), min, max);  \
+        return true;                                                    \
+    }                                                                   \
+    TYPE minValue = vector->items[0];                                   \
+    TYPE maxValue = vector->items[0];                                   \
+    for (uint32_t i = 1; i < vector->size; i++) {                       \
+        TYPE value = vector->items[i];                                  \
+        minValue = value < minValue ? value : minValue;                 \
+        maxValue = value > maxValue ? value : maxValue;                 \
+    }                                                                   \
+    *min = minValue;                                                    \
+    *max = maxValue;                                                    \
+    return true;                                                        \
+}                                      \
+\
+static TYPE VECTOR_METHOD(NAME, Min)(VECTOR_TYPEDEF(NAME) *vector) {   \
+    TYPE min = (TYPE) {0};                                              \
+    TYPE max;                                                           \
+    VECTOR_METHOD(NAME, MinMax)(vector, &min, &max);                    \
+    return min;                                                         \
+}                                      \
+\
+static TYPE VECTOR_METHOD(NAME, Max)(VECTOR_TYPEDEF(NAME) *vector) {   \
+    TYPE min;                                                           \
+    TYPE max = (TYPE) {0};                                              \
+    VECTOR_METHOD(NAME, MinMax)(vector, &min, &max);                    \
+    return max;                                                         \
+}                                      \
+\
+static int32_t NAME ##_indexOfExtreme(VECTOR_TYPEDEF(NAME) *vector, bool isMin) {   \
+    if (vector == NULL || vector->size == 0) return -1;                 \
+    if (NAME ##_isReduceKernel()) {     /* find value with kernel, then its first position */  \
+        TYPE min, max;                                                  \
+        vectorKernelMinMax(vector->items, vector->size, NAME ##_kind(), &min, &max);  \
+        TYPE extreme = isMin ? min : max;                               \
+        for (uint32_t i = 0; i < vector->size; i++) {                   \
+            if (vector->items[i] == extreme) return (int32_t) i;        \
+        }                                                               \
+    }                                                                   \
+    uint32_t index = 0;                                                 \
+    for (uint32_t i = 1; i < vector->size; i++) {                       \
+        TYPE value = vector->items[i];                                  \
+        if (isMin ? value < vector->items[index] : value > vector->items[index]) {  \
+            index = i;                                                  \
+        }                                                               \
+    }                                                                   \
+    return (int32_t) index;                                             \
+}                                      \
+\
+static int32_t VECTOR_METHOD(NAME, ArgMin)(VECTOR_TYPEDEF(NAME) *vector) {   /* first index of minimum, -1 when empty */  \
+    return NAME ##_indexOfExtreme(vector, true);                        \
+}                                      \
+\
+static int32_t VECTOR_METHOD(NAME, ArgMax)(VECTOR_TYPEDEF(NAME) *vector) {   \
+    return NAME ##_indexOfExtreme(vector, false);                       \
+}                                      \
+\
+static ACCUMULATOR_FOR_TYPE(TYPE) VECTOR_METHOD(NAME, Sum)(VECTOR_TYPEDEF(NAME) *vector) {   \
+    if (vector == NULL) return 0;                                       \
+    VectorElementKind kind = NAME ##_kind();                            \
+    if (kind == VECTOR_ELEMENT_I32 || kind == VECTOR_ELEMENT_U32) {     \
+        return (ACCUMULATOR_FOR_TYPE(TYPE)) vectorKernelSum32(vector->items, vector->size, kind == VECTOR_ELEMENT_I32);  \
+    }                                                                   \
+    if (kind == VECTOR_ELEMENT_F32 || kind == VECTOR_ELEMENT_F64) {     \
+        return (ACCUMULATOR_FOR_TYPE(TYPE)) vectorKernelSumFloat(vector->items, vector->size, kind);  \
+    }                                                                   \
+    ACCUMULATOR_FOR_TYPE(TYPE) sum = 0;                                 \
+    for (uint32_t i = 0; i < vector->size; i++) {                       \
+        sum += (ACCUMULATOR_FOR_TYPE(TYPE)) vector->items[i];           \
+    }                                                                   \
+    return sum;                                                         \
+}                                      \
+\
+static double VECTOR_METHOD(NAME, SumCompensated)(VECTOR_TYPEDEF(NAME) *vector) {   /* Neumaier summation, sequential */  \
+    if (vector == NULL) return 0;                                       \
+    double sum = 0;                                                     \
+    double compensation = 0;                                            \
+    for (uint32_t i = 0; i < vector->size; i++) {                       \
+        double value = (double) vector->items[i];                       \
+        double total = sum + value;                                     \
+        compensation += ((sum < 0 ? -sum : sum) >= (value < 0 ? -value : value)) ? (sum - total) + value : (value - total) + sum;  \
+        sum = total;                                                    \
+    }                                                                   \
+    return sum + compensation;                                          \
+}                                      \
+\
+static inline bool NAME ##_isFloatKernel(void) {   \
+    return NAME ##_kind() == VECTOR_ELEMENT_F32 || NAME ##_kind() == VECTOR_ELEMENT_F64;  \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, Axpy)(VECTOR_TYPEDEF(NAME) *y, TYPE alpha, VECTOR_TYPEDEF(NAME) *x) {  /* y += alpha * x, sizes must match */  \
+    if (y == NULL || x == NULL || y->size != x->size) return NULL;      \
+    if (NAME ##_isFloatKernel()) {                                      \
+        vectorKernelAxpy(y->items, x->items, y->size, NAME ##_kind(), (double) alpha);  \
+        return y;                                                       \
+    }                                                                   \
+    for (uint32_t i = 0; i < y->size; i++) {                            \
+        y->items[i] += alpha * x->items[i];                             \
+    }                                                                   \
+    return y;                                                           \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, ElementAdd)(VECTOR_TYPEDEF(NAME) *vecDest, VECTOR_TYPEDEF(NAME) *vecSource) {  \
+    return VECTOR_METHOD(NAME, Axpy)(vecDest, (TYPE) 1, vecSource);    \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, ElementMul)(VECTOR_TYPEDEF(NAME) *vecDest, VECTOR_TYPEDEF(NAME) *vecSource) {  \
+    if (vecDest == NULL || vecSource == NULL || vecDest->size != vecSource->size) return NULL;  \
+    if (NAME ##_isFloatKernel()) {                                      \
+        vectorKernelMultiply(vecDest->items, vecSource->items, vecDest->size, NAME ##_kind());  \
+        return vecDest;                                                 \
+    }                                                                   \
+    for (uint32_t i = 0; i < vecDest->size; i++) {                      \
+        vecDest->items[i] *= vecSource->items[i];                       \
+    }                                                                   \
+    return vecDest;                                                     \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, Scale)(VECTOR_TYPEDEF(NAME) *vector, TYPE factor) {  \
+    if (vector == NULL) return NULL;                                    \
+    if (NAME ##_isFloatKernel()) {                                      \
+        vectorKernelScale(vector->items, vector->size, NAME ##_kind(), (double) factor);  \
+        return vector;                                                  \
+    }                                                                   \
+    for (uint32_t i = 0; i < vector->size; i++) {                      \
+        vector->items[i] *= factor;                                     \
+    }                                                                   \
+    return vector;                                                      \
+}                                      \
+\
+/* Zero for NULL or vectors of different size, so sizes have to be checked first when zero is a valid product */  \
+static double VECTOR_METHOD(NAME, Dot)(VECTOR_TYPEDEF(NAME) *first, VECTOR_TYPEDEF(NAME) *second) {  \
+    if (first == NULL || second == NULL || first->size != second->size) return 0;  \
+    if (NAME ##_isFloatKernel()) {                                      \
+        return vectorKernelDot(first->items, second->items, first->size, NAME ##_kind());  \
+    }                                                                   \
+    double sum = 0;                                                     \
+    for (uint32_t i = 0; i < first->size; i++) {                        \
+        sum += (double) first->items[i] * (double) second->items[i];    \
+    }                                                                   \
+    return sum;                                                         \
+}                                      \
+\
+static double VECTOR_METHOD(NAME, Norm)(VECTOR_TYPEDEF(NAME) *vector) {   /* euclidean (L2) length */  \
+    return sqrt(VECTOR_METHOD(NAME, Dot)(vector, vector));              \
+}                                      \
+\
+static double VECTOR_METHOD(NAME, Cosine)(VECTOR_TYPEDEF(NAME) *first, VECTOR_TYPEDEF(NAME) *second) {  /* zero for zero length vectors */  \
+    double lengths = VECTOR_METHOD(NAME, Norm)(first) * VECTOR_METHOD(NAME, Norm)(second);  \
+    return lengths > 0 ? VECTOR_METHOD(NAME, Dot)(first, second) / lengths : 0;  \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * NAME ##_scan(VECTOR_TYPEDEF(NAME) *vector, bool isExclusive) {   \
+    if (vector == NULL) return NULL;                                    \
+    VectorElementKind kind = NAME ##_kind();                            \
+    if (kind == VECTOR_ELEMENT_I32 || kind == VECTOR_ELEMENT_U32) {     \
+        vectorKernelScan32(vector->items, vector->size, isExclusive, 0);  \
+        return vector;                                                  \
+    }                                                                   \
+    TYPE sum = (TYPE) 0;                                                \
+    for (uint32_t i = 0; i < vector->size; i++) {                       \
+        TYPE value = vector->items[i];                                  \
+        vector->items[i] = isExclusive ? sum : (TYPE) (sum + value);    \
+        sum += value;                                                   \
+    }                                                                   \
+    return vector;                                                      \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, InclusiveScan)(VECTOR_TYPEDEF(NAME) *vector) {  /* items[i] = sum of items[0..i] */  \
+    return NAME ##_scan(vector, false);                                 \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, ExclusiveScan)(VECTOR_TYPEDEF(NAME) *vector) {  /* items[i] = sum of items[0..i-1] */  \
+    return NAME ##_scan(vector, true);                                  \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * NAME ##_parallelScan(VECTOR_TYPEDEF(NAME) *vector, bool isExclusive, ThreadPool pool) {   \
+    if (vector == NULL) return NULL;                                    \
+    VectorElementKind kind = NAME ##_kind();                            \
+    if (kind == VECTOR_ELEMENT_I32 || kind == VECTOR_ELEMENT_U32) {     /* signed sums wrap same as unsigned ones */  \
+        parallelPrefixSum32((uint32_t *) vector->items, vector->size, isExclusive, pool);  \
+        return vector;                                                  \
+    }                                                                   \
+    return NAME ##_scan(vector, isExclusive);                           \
+}                                      \
+\
+/* Two pass scan of 32-bit items: block sums, then every block is scanned from own offset. Other types are scanned in caller */  \
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, ParallelInclusiveScan)(VECTOR_TYPEDEF(NAME) *vector, ThreadPool pool) {  \
+    return NAME ##_parallelScan(vector, false, pool);                   \
+}                                      \
+\
+static VECTOR_TYPEDEF(NAME) * VECTOR_METHOD(NAME, ParallelExclusiveScan)(VECTOR_TYPEDEF(NAME) *vector, ThreadPool pool) {  \
+    return NAME ##_parallelScan(vector, true, pool);                    \
+}                                      \
+\
+static bool VECTOR_METHOD(NAME, Histogram)(VECTOR_TYPEDEF(NAME) *vector, uint32_t *counts, uint32_t countsLength) {  \
+    if (vector == NULL || counts == NULL) return false;    /* counts[value] for values from 0 to countsLength - 1 */  \
+    VectorElementKind kind = NAME ##_kind();                            \
+    if (kind == VECTOR_ELEMENT_U8 || kind == VECTOR_ELEMENT_I8) {       \
+        vectorKernelHistogram8(vector->items, vector->size, kind == VECTOR_ELEMENT_I8, counts, countsLength);  \
+        return true;                                                    \
+    }                                                                   \
+    memset(counts, 0, sizeof(uint32_t) * countsLength);                 \
+    for (uint32_t i = 0; i < vector->size; i++) {                       \
+        int64_t value = (int64_t) vector->items[i];                     \
+        if (value >= 0 && value < countsLength) {                       \
+            counts[value]++;                                            \
+        }                                                               \
+    }                                                                   \
+    return true;                                                        \
+}                                      \
+\
+
+
+#define CREATE_NUMBER_VECTOR_METHODS_1(TYPE) CREATE_NUMBER_VECTOR_METHODS_NAME(TYPE, TYPE)
+#define CREATE_NUMBER_VECTOR_METHODS_2(TYPE, NAME) CREATE_NUMBER_VECTOR_METHODS_NAME(TYPE, NAME)
+#define CREATE_NUMBER_VECTOR_METHODS_MACRO(_1, _2, FUN, ...) FUN
+
+#define CREATE_NUMBER_VECTOR_METHODS(...)                                     \
+    CREATE_NUMBER_VECTOR_METHODS_MACRO(__VA_ARGS__,                           \
+                        CREATE_NUMBER_VECTOR_METHODS_2,                       \
+                        CREATE_NUMBER_VECTOR_METHODS_1,                       \
+                        ERROR)(__VA_ARGS__)
+
+// Scratch length required by <type>VecRemoveDupStable() for vector of given size
+#define VECTOR_DEDUP_SCRATCH_LENGTH(SIZE) (2 * (SIZE))
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Vector.h"
+#include "ThreadPool.h"
+
+// Set of private append buffers, one per thread. Every shard header sits on its own cache line, so writers never
+// share lines and need no atomics. Shards are either spliced into one Vector by collect or processed in place.
+// Shard can be used by one thread at a time, getThreadPoolWorkerIndex() is convenient shard number.
+
+#define SHARDED_VECTOR_MIN_CAPACITY 16  // items per shard allocated on first add
+
+typedef struct ShardedVector *ShardedVector;
+typedef void (*ShardFunction)(uint32_t shard, VectorValueType *items, uint32_t size, void *context);
+
+ShardedVector getShardedVectorInstance(uint32_t shardCount, uint32_t shardCapacity);    // 0 shards is one per CPU
+
+bool shardedVectorAdd(ShardedVector vector, uint32_t shard, VectorValueType item);  // false on bad shard or allocation
+VectorValueType shardedVectorGet(ShardedVector vector, uint32_t shard, uint32_t index);
+
+uint32_t getShardCount(ShardedVector vector);
+uint32_t getShardSize(ShardedVector vector, uint32_t shard);
+uint32_t getShardedVectorSize(ShardedVector vector);   // sum of shards, only exact when no thread is adding
+
+// Appends every shard to 'dest' in shard order and empties shards, their memory is kept for next round.
+// Capacity is grown once, then shards are copied in bulk to one window of vectorReserveRange() and committed.
+// Returns false and keeps shards when 'dest' can't grow or its uncommitted windows leave no room,
+// 'dest' is never grown while such windows exist because growth would move them
+bool shardedVectorCollect(ShardedVector vector, Vector dest, ThreadPool pool);
+
+// Calls function once for every non empty shard with its items in place, shards run concurrently. No merge is done
+void shardedVectorForEach(ShardedVector vector, ShardFunction function, void *context, ThreadPool pool);
+
+void shardedVectorClear(ShardedVector vector);
+void shardedVectorDelete(ShardedVector vector);
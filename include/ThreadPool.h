@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Fixed set of worker threads. Ranges of parallelFor() are split lazily into work-stealing deques (Chase-Lev),
+// idle threads steal bigger halves from others. Caller thread always takes part in the work.
+// Without VECTOR_ENABLE_THREADS no pool is created and everything runs on caller thread.
+
+typedef struct ThreadPool *ThreadPool;
+typedef void (*ThreadPoolTask)(void *context);
+typedef void (*ParallelForFunction)(uint32_t begin, uint32_t end, void *context);   // processes [begin, end)
+
+ThreadPool getThreadPoolInstance(uint32_t threadCount);     // 0 creates one thread per online CPU
+
+bool threadPoolSubmit(ThreadPool pool, ThreadPoolTask task, void *context);
+void threadPoolWait(ThreadPool pool);       // returns when every submitted task is completed
+
+// Calls function on subranges of [begin, end) no longer than 'grain' in parallel, returns when whole range is done.
+// Can be nested from inside of running function. NULL pool runs subranges one by one on caller thread
+void parallelFor(ThreadPool pool, uint32_t begin, uint32_t end, uint32_t grain, ParallelForFunction function, void *context);
+
+uint32_t getThreadPoolSize(ThreadPool pool);    // worker threads including caller, 1 for NULL pool
+// Index of calling thread below getThreadPoolSize(), stable for thread lifetime. Every thread outside of pool gets
+// the last index, so only one of them may rely on it at a time. Always 0 for NULL pool
+uint32_t getThreadPoolWorkerIndex(ThreadPool pool);
+uint32_t getOnlineCpuCount(void);
+
+void threadPoolDelete(ThreadPool pool);
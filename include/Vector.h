@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include "VectorParallel.h"
 
 typedef struct Vector *Vector;
 typedef void* VectorValueType; // Vector can keep any type, change for specific
@@ -17,10 +18,29 @@ void vectorPut(Vector vector, uint32_t index, VectorValueType item);
 void vectorAddAt(Vector vector, uint32_t index, VectorValueType item);
 VectorValueType vectorRemoveAt(Vector vector, uint32_t index);
 
+// Grows by doubling, never shrinks. Returns false without growing while uncommitted windows of vectorReserveRange() exist
+bool vectorEnsureCapacity(Vector vector, uint32_t capacity);
+
+// Zero-copy parallel fill: capacity is grown first, then writer threads claim disjoint windows after current size
+// and write items directly. Only vectorReserveRange() can run concurrently. Windows become part of vector
+// when vectorCommitRanges() is called after every writer is finished. Vector can't be changed before that,
+// except vectorClear() that drops uncommitted windows. Growth is refused until commit, so windows never move
+VectorValueType *vectorReserveRange(Vector vector, uint32_t count);     // NULL when window doesn't fit in capacity
+uint32_t vectorCommitRanges(Vector vector);     // returns new size
+
 bool isVectorEmpty(Vector vector);
 bool isVectorNotEmpty(Vector vector);
 uint32_t getVectorSize(Vector vector);
 
+// Comparator gets pointers to VectorValueType elements, small vectors are sorted sequentially
+void vectorParallelSort(Vector vector, ParallelComparator comparator, ThreadPool pool);
+
+// Functions get pointers to VectorValueType elements, see parallelForEach(), parallelMap() and parallelReduce()
+void vectorParallelForEach(Vector vector, ParallelItemFunction function, void *context, ThreadPool pool);
+void vectorParallelMap(Vector vector, void *results, uint32_t resultSize, ParallelMapFunction function, void *context, ThreadPool pool);
+bool vectorParallelReduce(Vector vector, const ParallelReducer *reducer, void *result, ThreadPool pool);
+int32_t vectorParallelIndexOf(Vector vector, ParallelPredicate predicate, void *context, ThreadPool pool);  // first match or -1
+
 void vectorClear(Vector vector);
 void vectorDelete(Vector vector);
 
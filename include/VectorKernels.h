@@ -0,0 +1,140 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <string.h>
+
+// Element kind of generated vector, used to route typed vectors to specialized kernels
+typedef enum VectorElementKind {
+    VECTOR_ELEMENT_ANY = 0,     // custom type or custom comparator, only COMPARE_FUN is used
+    VECTOR_ELEMENT_I8,
+    VECTOR_ELEMENT_U8,
+    VECTOR_ELEMENT_I16,
+    VECTOR_ELEMENT_U16,
+    VECTOR_ELEMENT_I32,
+    VECTOR_ELEMENT_U32,
+    VECTOR_ELEMENT_I64,
+    VECTOR_ELEMENT_U64,
+    VECTOR_ELEMENT_F32,
+    VECTOR_ELEMENT_F64
+} VectorElementKind;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VECTOR_TYPE_IS(TYPE, OTHER) __builtin_types_compatible_p(TYPE, OTHER)
+#else
+#define VECTOR_TYPE_IS(TYPE, OTHER) 0     // no type detection, all vectors use generic code
+#endif
+
+#define VECTOR_INTEGER_KIND(SIZE, IS_SIGNED)                                       \
+    ((SIZE) == 1 ? ((IS_SIGNED) ? VECTOR_ELEMENT_I8 : VECTOR_ELEMENT_U8) :         \
+     (SIZE) == 2 ? ((IS_SIGNED) ? VECTOR_ELEMENT_I16 : VECTOR_ELEMENT_U16) :       \
+     (SIZE) == 4 ? ((IS_SIGNED) ? VECTOR_ELEMENT_I32 : VECTOR_ELEMENT_U32) :       \
+     (SIZE) == 8 ? ((IS_SIGNED) ? VECTOR_ELEMENT_I64 : VECTOR_ELEMENT_U64) : VECTOR_ELEMENT_ANY)
+
+#define VECTOR_IS_SIGNED_INTEGER(TYPE)                                              \
+    (VECTOR_TYPE_IS(TYPE, signed char) || VECTOR_TYPE_IS(TYPE, short) ||           \
+     VECTOR_TYPE_IS(TYPE, int) || VECTOR_TYPE_IS(TYPE, long) || VECTOR_TYPE_IS(TYPE, long long))
+
+#define VECTOR_IS_UNSIGNED_INTEGER(TYPE)                                            \
+    (VECTOR_TYPE_IS(TYPE, unsigned char) || VECTOR_TYPE_IS(TYPE, unsigned short) ||\
+     VECTOR_TYPE_IS(TYPE, unsigned int) || VECTOR_TYPE_IS(TYPE, unsigned long) ||  \
+     VECTOR_TYPE_IS(TYPE, unsigned long long))
+
+#define VECTOR_ELEMENT_KIND(TYPE)                                                   \
+    (VECTOR_TYPE_IS(TYPE, char) ? VECTOR_INTEGER_KIND(1, CHAR_MIN < 0) :           \
+     VECTOR_IS_SIGNED_INTEGER(TYPE) ? VECTOR_INTEGER_KIND(sizeof(TYPE), 1) :       \
+     VECTOR_IS_UNSIGNED_INTEGER(TYPE) ? VECTOR_INTEGER_KIND(sizeof(TYPE), 0) :     \
+     VECTOR_TYPE_IS(TYPE, float) ? VECTOR_ELEMENT_F32 :                            \
+     VECTOR_TYPE_IS(TYPE, double) ? VECTOR_ELEMENT_F64 : VECTOR_ELEMENT_ANY)
+
+typedef enum VectorCompareOperator {  // predicate for element compaction: 'element <operator> first'
+    VECTOR_LESS = 0,
+    VECTOR_LESS_OR_EQUAL,
+    VECTOR_GREATER,
+    VECTOR_GREATER_OR_EQUAL,
+    VECTOR_EQUAL,
+    VECTOR_NOT_EQUAL,
+    VECTOR_BETWEEN                  // first <= element <= second
+} VectorCompareOperator;
+
+typedef enum VectorCountingOperation {  // result of counting pass is always sorted
+    VECTOR_COUNTING_SORT = 0,       // every value
+    VECTOR_COUNTING_UNIQUE,         // each value once
+    VECTOR_COUNTING_SINGLE,         // values that occur exactly once
+    VECTOR_COUNTING_INTERSECT,      // values from both arrays, once
+    VECTOR_COUNTING_SUBTRACT        // each value repeated by its count difference between arrays
+} VectorCountingOperation;
+
+#define VECTOR_KERNEL_NO_MEMORY UINT32_MAX  // kernel could not allocate working memory, caller should use generic code
+#define VECTOR_KERNEL_RANGE_TOO_WIDE (UINT32_MAX - 1)   // value range too wide for counting kernel, caller should use generic code
+
+#define VECTOR_IS_COUNTING_KIND(KIND) ((KIND) >= VECTOR_ELEMENT_I8 && (KIND) <= VECTOR_ELEMENT_U16)
+
+
+// Both arrays must be sorted and must not contain duplicates
+uint32_t vectorKernelIntersectCount32(const void *first, uint32_t firstSize, const void *second, uint32_t secondSize, bool isSigned);
+
+// Keeps matching 32-bit elements in place (or drops them when 'isRetained' is false), returns new element count
+uint32_t vectorKernelCompact32(void *items, uint32_t size, VectorElementKind kind, VectorCompareOperator compareOperator,
+                               const void *first, const void *second, bool isRetained);
+
+// Writes smallest and largest element of non-empty I32, U32, F32 or F64 array, result is unspecified when array has NaN
+void vectorKernelMinMax(const void *items, uint32_t size, VectorElementKind kind, void *min, void *max);
+
+// Sum of 32-bit integers widened to 64 bits, signed result is returned as two's complement
+uint64_t vectorKernelSum32(const void *items, uint32_t size, bool isSigned);
+
+// Sum of F32 or F64 array in double precision, order of additions is unspecified
+double vectorKernelSumFloat(const void *items, uint32_t size, VectorElementKind kind);
+
+// Dense F32 or F64 arithmetic, FMA is used when CPU supports it
+void vectorKernelAxpy(void *y, const void *x, uint32_t size, VectorElementKind kind, double alpha);    // y += alpha * x
+void vectorKernelMultiply(void *dest, const void *source, uint32_t size, VectorElementKind kind);
+void vectorKernelScale(void *items, uint32_t size, VectorElementKind kind, double factor);
+double vectorKernelDot(const void *first, const void *second, uint32_t size, VectorElementKind kind);   // always accumulated in double
+
+// In-place prefix sums of 32-bit integers starting from 'offset', returns total including offset.
+// Blocks can be scanned independently after their offsets are known from vectorKernelSum32()
+uint32_t vectorKernelScan32(void *items, uint32_t size, bool isExclusive, uint32_t offset);
+
+// Counts 8-bit values from 0 to 'countsLength' - 1, other values are skipped
+void vectorKernelHistogram8(const void *items, uint32_t size, bool isSigned, uint32_t *counts, uint32_t countsLength);
+
+// dest[i] = source[indexes[i]] for elements of any size, 4 and 8-byte elements use SIMD gathers.
+// Every index must be below 'sourceSize', arrays must not overlap
+void vectorKernelGather(void *dest, const void *source, uint32_t sourceSize, const uint32_t *indexes, uint32_t count, uint32_t elementSize);
+
+typedef struct VectorSortKey {  // extracted sort key with position of its element
+    uint64_t key;
+    uint32_t index;
+} VectorSortKey;
+
+static inline uint64_t vectorSignedKey(int64_t value) {    // integer key with same order as signed value
+    return (uint64_t) value ^ 0x8000000000000000u;
+}
+
+static inline uint64_t vectorFloatKey(double value) {      // same order as value, negative NaN goes first and positive last
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(double));
+    return (bits & 0x8000000000000000u) ? ~bits : bits ^ 0x8000000000000000u;
+}
+
+// Stable LSD radix sort of keys, 'buffer' has same length. Returns array with sorted keys, either 'keys' or 'buffer'
+VectorSortKey *vectorKernelRadixSortKeys(VectorSortKey *keys, VectorSortKey *buffer, uint32_t size);
+
+// Sorts or filters 8 and 16-bit integers in place with counting pass over value range, O(n + range) without comparisons.
+// 'source' is used only by VECTOR_COUNTING_INTERSECT and VECTOR_COUNTING_SUBTRACT. Returns new size,
+// VECTOR_KERNEL_RANGE_TOO_WIDE when value range is a few times wider than element count, so comparison sort is cheaper,
+// or VECTOR_KERNEL_NO_MEMORY when counters can't be allocated
+uint32_t vectorKernelCountingOperation(void *items, uint32_t size, const void *source, uint32_t sourceSize,
+                                       VectorElementKind kind, VectorCountingOperation operation);
+
+#define VECTOR_SORT_NETWORK_MAX 16      // largest element count with sorting network
+#define VECTOR_INSERTION_SORT_MAX 32    // largest element count sorted by insertion sort
+
+// Returns comparator index pairs (two bytes per comparator) of sorting network for 'size' elements, NULL when size is too large
+const uint8_t *vectorSortNetwork(uint32_t size, uint32_t *pairCount);
+
+// Sorts up to 32 I32, U32 or F32 elements with SIMD bitonic networks, returns false when not applied (no AVX2, NaN values)
+bool vectorKernelSortSmall32(void *items, uint32_t size, VectorElementKind kind);
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ThreadPool.h"
+#include "VectorKernels.h"
+
+#define PARALLEL_SORT_MIN_SIZE 65536    // smaller arrays are sorted by caller thread only
+#define PARALLEL_SEARCH_MIN_SIZE 65536  // smaller arrays are searched by caller thread only
+#define PARALLEL_CHUNK_BYTES 32768      // for-each, map and reduce ranges stay in L1/L2 cache
+#define PARALLEL_REDUCE_CHUNKS_PER_THREAD 4
+#define PARALLEL_MERGE_MIN_SIZE 65536   // smaller set operations are merged by caller thread only
+#define MERGE_PATH_SEGMENTS_PER_THREAD 4
+
+typedef int (*ParallelComparator)(const void *one, const void *two);   // same contract as qsort() comparator
+typedef void (*ParallelItemFunction)(void *item, void *context);
+typedef bool (*ParallelPredicate)(const void *item, void *context);
+typedef uint32_t (*ParallelRangeSearch)(const void *items, uint32_t begin, uint32_t end, void *context);   // first match or end
+typedef void (*ParallelMapFunction)(const void *item, void *result, void *context);
+typedef void (*ParallelAccumulator)(void *partial, const void *item, void *context);    // folds item into partial result
+typedef void (*ParallelCombiner)(void *partial, const void *other, void *context);      // folds next partial result
+
+typedef struct MergePathSegment {   // independent part of two sorted inputs and its place in output
+    uint32_t firstFrom;
+    uint32_t firstTo;
+    uint32_t secondFrom;
+    uint32_t secondTo;
+    uint32_t outputFrom;
+    void *output;                   // output array of whole merge, segment starts at 'outputFrom' element
+} MergePathSegment;
+
+// Finds split of sorted inputs after 'diagonal' merged elements. Equal values must not be split between segments
+typedef void (*MergePathSplit)(uint32_t diagonal, uint32_t *firstIndex, uint32_t *secondIndex, void *context);
+typedef uint32_t (*MergePathMerge)(const MergePathSegment *segment, bool isCounting, void *context);   // output length
+
+typedef struct ParallelReducer {
+    uint32_t resultSize;
+    ParallelAccumulator accumulate;
+    ParallelCombiner combine;
+    void *context;
+    bool isDeterministic;   // chunk boundaries don't depend on pool size, so floating point results are repeatable
+} ParallelReducer;
+
+// Parallel sample sort: elements are split in buckets by sampled splitters, then buckets are sorted concurrently.
+// Falls back to qsort() for small arrays, single thread pool or when working memory can't be allocated
+void parallelSort(void *items, uint32_t size, uint32_t elementSize, ParallelComparator comparator, ThreadPool pool);
+
+// Parallel LSD radix sort of I32, U32, I64 or U64 array with per-thread digit histograms.
+// Passes where all keys share a digit are skipped. Returns false for other kinds or when buffer can't be allocated
+bool parallelRadixSort(void *items, uint32_t size, VectorElementKind kind, ThreadPool pool);
+
+// Calls function with pointer to every element, ranges of PARALLEL_CHUNK_BYTES are processed concurrently
+void parallelForEach(void *items, uint32_t size, uint32_t elementSize, ParallelItemFunction function, void *context, ThreadPool pool);
+
+// Writes result of every element at the same index of 'results' array with elements of 'resultSize' bytes
+void parallelMap(const void *items, void *results, uint32_t size, uint32_t elementSize, uint32_t resultSize,
+                 ParallelMapFunction function, void *context, ThreadPool pool);
+
+// 'result' holds identity value on call and reduced value on return. Every chunk is accumulated from identity,
+// then partial results are combined in index order. Returns false when partial results can't be allocated
+bool parallelReduce(const void *items, uint32_t size, uint32_t elementSize, const ParallelReducer *reducer, void *result, ThreadPool pool);
+
+// First index in array where search callback finds a match or -1. Ranges of PARALLEL_CHUNK_BYTES are searched
+// concurrently, found index is kept as atomic minimum so ranges after it are skipped
+int32_t parallelSearch(const void *items, uint32_t size, uint32_t elementSize, ParallelRangeSearch search, void *context, ThreadPool pool);
+int32_t parallelFindFirst(const void *items, uint32_t size, uint32_t elementSize, ParallelPredicate predicate, void *context, ThreadPool pool);
+
+// In-place prefix sum of uint32_t array: block sums, scan of block sums, then every block is scanned with own offset
+void parallelPrefixSum32(uint32_t *items, uint32_t size, bool isExclusive, ThreadPool pool);
+
+// Merge path partitioning: sorted inputs are split by equal output diagonals into segments that are merged concurrently.
+// Segments are counted first, output positions are placed by sequential prefix sum of the few segment counts,
+// then segments are written to 'output' that must not overlap inputs.
+// Returns false when segments can't be allocated
+bool parallelMergePath(uint32_t firstSize, uint32_t secondSize, void *output, MergePathSplit split, MergePathMerge merge,
+                       void *context, ThreadPool pool, uint32_t *outputSize);
+
+// Merge path with result in place of first input: segments are written to scratch array of 'capacity' elements,
+// then it's copied to 'first'. Returns false when scratch or segments can't be allocated, 'first' is not changed then
+bool parallelMergeIntoFirst(void *first, uint32_t firstSize, uint32_t secondSize, uint32_t elementSize, uint32_t capacity,
+                            MergePathSplit split, MergePathMerge merge, void *context, ThreadPool pool, uint32_t *outputSize);
+
+void parallelCopy(void *dest, const void *source, uint32_t size, uint32_t elementSize, ThreadPool pool);